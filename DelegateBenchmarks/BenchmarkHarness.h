@@ -0,0 +1,166 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace Benchmarks
+{
+    // ======================= Allocation Counting =======================
+
+    // Incremented by the global operator new replacement in BENCHMARK_DEFINE_ALLOCATION_COUNTING.
+    inline std::atomic<uint64_t> GNumAllocations(0);
+
+    __forceinline uint64_t GetNumAllocations() { return GNumAllocations.load(std::memory_order_relaxed); }
+
+    // Backing store of the replaced allocation functions. Over-aligned blocks are carved out of a larger malloc block,
+    // with the pointer malloc returned stored just before them, so each kind is freed by its matching path.
+    inline void* AllocateCounted(std::size_t Size, std::size_t Alignment) noexcept
+    {
+        GNumAllocations.fetch_add(1, std::memory_order_relaxed);
+        if (Size == 0) Size = 1;
+        if (Alignment <= alignof(std::max_align_t)) return std::malloc(Size);
+
+        void* Raw = std::malloc(Size + Alignment + sizeof(void*));
+        if (!Raw) return nullptr;
+
+        const std::uintptr_t Aligned = (reinterpret_cast<std::uintptr_t>(Raw) + sizeof(void*) + Alignment - 1) & ~(Alignment - 1);
+        reinterpret_cast<void**>(Aligned)[-1] = Raw;
+        return reinterpret_cast<void*>(Aligned);
+    }
+
+    inline void FreeCounted(void* Ptr, std::size_t Alignment) noexcept
+    {
+        if (!Ptr) return;
+
+        if (Alignment <= alignof(std::max_align_t)) std::free(Ptr);
+        else std::free(static_cast<void**>(Ptr)[-1]);
+    }
+
+    inline void* AllocateCountedOrThrow(std::size_t Size, std::size_t Alignment)
+    {
+        if (void* Ptr = AllocateCounted(Size, Alignment)) return Ptr;
+        throw std::bad_alloc();
+    }
+
+    // ======================= Optimization Barriers =======================
+
+    inline const void* volatile GEscapedPointer = nullptr;
+
+    // Publishing the address makes the value observable, so the computation producing it cannot be dropped.
+    template <typename T>
+    __forceinline void DoNotOptimize(const T& Value)
+    {
+        GEscapedPointer = &Value;
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+    }
+
+    __forceinline void ClobberMemory() { std::atomic_signal_fence(std::memory_order_seq_cst); }
+
+    // ======================= Runner =======================
+
+    struct FBenchmarkResult
+    {
+        std::string Name;
+        double NanosecondsPerOp = 0.0;
+        double AllocationsPerOp = 0.0;
+    };
+
+    class FBenchmarkRunner
+    {
+    public:
+        explicit FBenchmarkRunner(const char* InFilter) : Filter(InFilter ? InFilter : "") {}
+
+        bool ShouldRun(const std::string& InName) const { return Filter.empty() || InName.find(Filter) != std::string::npos; }
+
+        // Runs InBody(NumOps) a few times and keeps the fastest run. InBody performs NumOps operations and may do
+        // untimed setup by calling PauseTiming/ResumeTiming.
+        template <typename BodyFunc>
+        void Run(const std::string& InName, uint64_t InNumOps, BodyFunc&& InBody, int InRepetitions = 5)
+        {
+            if (!ShouldRun(InName) || InNumOps == 0) return;
+
+            FBenchmarkResult Best;
+            Best.Name = InName;
+            Best.NanosecondsPerOp = 1e300;
+
+            for (int Repetition = 0; Repetition < InRepetitions; ++Repetition)
+            {
+                PausedNanoseconds = 0;
+                const uint64_t AllocationsBefore = GetNumAllocations();
+                const auto Start = std::chrono::steady_clock::now();
+
+                InBody(InNumOps);
+
+                const auto End = std::chrono::steady_clock::now();
+                const uint64_t Allocations = GetNumAllocations() - AllocationsBefore - PausedAllocations;
+                PausedAllocations = 0;
+
+                const double Elapsed = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(End - Start).count() - PausedNanoseconds);
+                const double PerOp = Elapsed / static_cast<double>(InNumOps);
+                if (PerOp < Best.NanosecondsPerOp)
+                {
+                    Best.NanosecondsPerOp = PerOp;
+                    Best.AllocationsPerOp = static_cast<double>(Allocations) / static_cast<double>(InNumOps);
+                }
+            }
+
+            std::printf("%-64s %12.2f ns/op %10.3f allocs/op\n", Best.Name.c_str(), Best.NanosecondsPerOp, Best.AllocationsPerOp);
+            Results.push_back(std::move(Best));
+        }
+
+        void PauseTiming()
+        {
+            PauseStart = std::chrono::steady_clock::now();
+            PauseAllocationsStart = GetNumAllocations();
+        }
+
+        void ResumeTiming()
+        {
+            PausedNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - PauseStart).count();
+            PausedAllocations += GetNumAllocations() - PauseAllocationsStart;
+        }
+
+        const std::vector<FBenchmarkResult>& GetResults() const { return Results; }
+
+    private:
+        std::string Filter;
+        std::vector<FBenchmarkResult> Results;
+
+        std::chrono::steady_clock::time_point PauseStart;
+        int64_t PausedNanoseconds = 0;
+        uint64_t PauseAllocationsStart = 0;
+        uint64_t PausedAllocations = 0;
+    };
+}
+
+// Replaces the global allocation functions of the including executable so GetNumAllocations counts every heap
+// allocation, over-aligned and nothrow ones included. Use exactly once, in the translation unit that defines main.
+#define BENCHMARK_DEFINE_ALLOCATION_COUNTING() \
+    void* operator new(std::size_t Size) { return Benchmarks::AllocateCountedOrThrow(Size, 0); } \
+    void* operator new[](std::size_t Size) { return Benchmarks::AllocateCountedOrThrow(Size, 0); } \
+    void* operator new(std::size_t Size, std::align_val_t Alignment) { return Benchmarks::AllocateCountedOrThrow(Size, static_cast<std::size_t>(Alignment)); } \
+    void* operator new[](std::size_t Size, std::align_val_t Alignment) { return Benchmarks::AllocateCountedOrThrow(Size, static_cast<std::size_t>(Alignment)); } \
+    void* operator new(std::size_t Size, const std::nothrow_t&) noexcept { return Benchmarks::AllocateCounted(Size, 0); } \
+    void* operator new[](std::size_t Size, const std::nothrow_t&) noexcept { return Benchmarks::AllocateCounted(Size, 0); } \
+    void* operator new(std::size_t Size, std::align_val_t Alignment, const std::nothrow_t&) noexcept { return Benchmarks::AllocateCounted(Size, static_cast<std::size_t>(Alignment)); } \
+    void* operator new[](std::size_t Size, std::align_val_t Alignment, const std::nothrow_t&) noexcept { return Benchmarks::AllocateCounted(Size, static_cast<std::size_t>(Alignment)); } \
+    void operator delete(void* Ptr) noexcept { Benchmarks::FreeCounted(Ptr, 0); } \
+    void operator delete[](void* Ptr) noexcept { Benchmarks::FreeCounted(Ptr, 0); } \
+    void operator delete(void* Ptr, std::size_t) noexcept { Benchmarks::FreeCounted(Ptr, 0); } \
+    void operator delete[](void* Ptr, std::size_t) noexcept { Benchmarks::FreeCounted(Ptr, 0); } \
+    void operator delete(void* Ptr, const std::nothrow_t&) noexcept { Benchmarks::FreeCounted(Ptr, 0); } \
+    void operator delete[](void* Ptr, const std::nothrow_t&) noexcept { Benchmarks::FreeCounted(Ptr, 0); } \
+    void operator delete(void* Ptr, std::align_val_t Alignment) noexcept { Benchmarks::FreeCounted(Ptr, static_cast<std::size_t>(Alignment)); } \
+    void operator delete[](void* Ptr, std::align_val_t Alignment) noexcept { Benchmarks::FreeCounted(Ptr, static_cast<std::size_t>(Alignment)); } \
+    void operator delete(void* Ptr, std::size_t, std::align_val_t Alignment) noexcept { Benchmarks::FreeCounted(Ptr, static_cast<std::size_t>(Alignment)); } \
+    void operator delete[](void* Ptr, std::size_t, std::align_val_t Alignment) noexcept { Benchmarks::FreeCounted(Ptr, static_cast<std::size_t>(Alignment)); } \
+    void operator delete(void* Ptr, std::align_val_t Alignment, const std::nothrow_t&) noexcept { Benchmarks::FreeCounted(Ptr, static_cast<std::size_t>(Alignment)); } \
+    void operator delete[](void* Ptr, std::align_val_t Alignment, const std::nothrow_t&) noexcept { Benchmarks::FreeCounted(Ptr, static_cast<std::size_t>(Alignment)); }
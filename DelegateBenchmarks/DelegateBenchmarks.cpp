@@ -0,0 +1,1056 @@
+#include <array>
+#include <coroutine>
+#include <functional>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <thread>
+
+#include "BenchmarkHarness.h"
+#include "DelegateExecutor.h"
+#include "DelegateInstance.h"
+#include "FastDelegate.h"
+#include "ShardedMulticastDelegate.h"
+#include "StaticMulticastDelegate.h"
+#include "ThreadSafeMulticastDelegate.h"
+
+BENCHMARK_DEFINE_ALLOCATION_COUNTING()
+
+namespace
+{
+    using FSignal = void(int, int, int);
+    using FUnicast = Delegates::TDelegate<FSignal>;
+    using FFastUnicast = Delegates::TFastDelegate<FSignal>;
+    using FMulticast = Delegates::TMulticastDelegate<FSignal>;
+    using FThreadSafeMulticast = Delegates::TThreadSafeMulticastDelegate<FSignal>;
+    using FShardedMulticast = Delegates::TShardedMulticastDelegate<FSignal>;
+    using FFunctionVector = std::vector<std::function<FSignal>>;
+
+    using FPoolAllocator = Delegates::TDelegatePoolAllocator<FSignal>;
+    using FArenaAllocator = Delegates::TDelegateFrameArenaAllocator<FSignal>;
+
+    using Benchmarks::DoNotOptimize;
+    using Benchmarks::FBenchmarkRunner;
+
+    const size_t ListenerCounts[] = { 1, 10, 100, 1000, 10000, 100000 };
+
+    struct FListener
+    {
+        void Update(int MaxHealth, int Health, int Delta) { Sum += static_cast<uint64_t>(MaxHealth + Health + Delta); }
+
+        uint64_t Sum = 0;
+    };
+
+    struct FOtherListener
+    {
+        void Update(int MaxHealth, int Health, int Delta) { Sum += static_cast<uint64_t>(MaxHealth - Health - Delta); }
+
+        uint64_t Sum = 0;
+    };
+
+    uint64_t GStaticSum = 0;
+    void StaticListener(int MaxHealth, int Health, int Delta) { GStaticSum += static_cast<uint64_t>(MaxHealth + Health + Delta); }
+
+    // Keeps total work per benchmark roughly constant across listener counts.
+    uint64_t GetNumBroadcasts(size_t InNumListeners) { return std::max<uint64_t>(1, 2'000'000 / InNumListeners); }
+
+    std::string MakeName(const char* InGroup, const char* InVariant, size_t InCount)
+    {
+        return std::string(InGroup) + "/" + InVariant + "/" + std::to_string(InCount);
+    }
+
+    // ======================= Bind =======================
+
+    void RunBindBenchmarks(FBenchmarkRunner& Runner)
+    {
+        constexpr uint64_t NumBinds = 1'000'000;
+
+        FListener Listener;
+        auto SharedListener = std::make_shared<FListener>();
+        const std::weak_ptr<FListener> WeakListener = SharedListener;
+
+        Runner.Run("Bind/TDelegate/Static", NumBinds, [&](uint64_t NumOps)
+            {
+                FUnicast Delegate;
+                for (uint64_t Op = 0; Op < NumOps; ++Op) { Delegate.BindStatic(&StaticListener); DoNotOptimize(Delegate); }
+            });
+
+        Runner.Run("Bind/TDelegate/Raw", NumBinds, [&](uint64_t NumOps)
+            {
+                FUnicast Delegate;
+                for (uint64_t Op = 0; Op < NumOps; ++Op) { Delegate.AddRaw(&Listener, &FListener::Update); DoNotOptimize(Delegate); }
+            });
+
+        Runner.Run("Bind/TDelegate/Weak", NumBinds, [&](uint64_t NumOps)
+            {
+                FUnicast Delegate;
+                for (uint64_t Op = 0; Op < NumOps; ++Op) { Delegate.AddWeak(WeakListener, &FListener::Update); DoNotOptimize(Delegate); }
+            });
+
+        Runner.Run("Bind/TDelegate/Lambda", NumBinds, [&](uint64_t NumOps)
+            {
+                FUnicast Delegate;
+                for (uint64_t Op = 0; Op < NumOps; ++Op)
+                {
+                    Delegate.AddLambda([&Listener](int A, int B, int C) { Listener.Update(A, B, C); });
+                    DoNotOptimize(Delegate);
+                }
+            });
+
+        Runner.Run("Bind/TDelegate/LambdaLargeCapture", NumBinds, [&](uint64_t NumOps)
+            {
+                FUnicast Delegate;
+                const std::array<uint64_t, 16> Payload{};
+                for (uint64_t Op = 0; Op < NumOps; ++Op)
+                {
+                    Delegate.AddLambda([&Listener, Payload](int A, int B, int C) { Listener.Update(A + static_cast<int>(Payload[0]), B, C); });
+                    DoNotOptimize(Delegate);
+                }
+            });
+
+        // Large captures do not fit inline; these measure the allocator policy that serves them.
+        const auto RunLargeCaptureBind = [&](const char* InVariant, auto&& InDelegate)
+            {
+                Runner.Run(std::string("Bind/TDelegate/LambdaLargeCapture/") + InVariant, NumBinds, [&](uint64_t NumOps)
+                    {
+                        const std::array<uint64_t, 16> Payload{};
+                        for (uint64_t Op = 0; Op < NumOps; ++Op)
+                        {
+                            InDelegate.AddLambda([&Listener, Payload](int A, int B, int C) { Listener.Update(A + static_cast<int>(Payload[0]), B, C); });
+                            DoNotOptimize(InDelegate);
+                        }
+                        InDelegate.Unbind();
+                    });
+            };
+
+        RunLargeCaptureBind("Pool", Delegates::TDelegate<FSignal, Delegates::DefaultDelegateInlineSize, FPoolAllocator>());
+
+        // Frame arena memory is reclaimed per frame; one frame here is 1000 binds.
+        Runner.Run("Bind/TDelegate/LambdaLargeCapture/FrameArena", NumBinds, [&](uint64_t NumOps)
+            {
+                const std::array<uint64_t, 16> Payload{};
+                for (uint64_t Op = 0; Op < NumOps; ++Op)
+                {
+                    {
+                        Delegates::TDelegate<FSignal, Delegates::DefaultDelegateInlineSize, FArenaAllocator> Delegate;
+                        Delegate.AddLambda([&Listener, Payload](int A, int B, int C) { Listener.Update(A + static_cast<int>(Payload[0]), B, C); });
+                        DoNotOptimize(Delegate);
+                    }
+
+                    // The frame's bindings are all destroyed by now, as Reset requires.
+                    if ((Op + 1) % 1000 == 0) FArenaAllocator::ResetFrame();
+                }
+            });
+
+        Runner.Run("Bind/std::function/Lambda", NumBinds, [&](uint64_t NumOps)
+            {
+                std::function<FSignal> Function;
+                for (uint64_t Op = 0; Op < NumOps; ++Op)
+                {
+                    Function = [&Listener](int A, int B, int C) { Listener.Update(A, B, C); };
+                    DoNotOptimize(Function);
+                }
+            });
+
+        constexpr size_t NumPerDelegate = 1000;
+
+        // Multicast binds are measured in batches so the vectors reach a realistic size; Clear is not timed.
+        const auto RunMulticastBind = [&](const char* InVariant, auto&& InBind)
+            {
+                Runner.Run(std::string("Bind/TMulticastDelegate/") + InVariant, NumBinds, [&](uint64_t NumOps)
+                    {
+                        FMulticast Delegate;
+                        for (uint64_t Op = 0; Op < NumOps; ++Op)
+                        {
+                            InBind(Delegate);
+                            if ((Op + 1) % NumPerDelegate == 0)
+                            {
+                                Runner.PauseTiming();
+                                Delegate.Clear();
+                                Runner.ResumeTiming();
+                            }
+                        }
+                    });
+            };
+
+        RunMulticastBind("Static", [&](FMulticast& Delegate) { Delegate.AddStatic(&StaticListener); });
+        RunMulticastBind("Raw", [&](FMulticast& Delegate) { Delegate.AddRaw(&Listener, &FListener::Update); });
+        RunMulticastBind("Weak", [&](FMulticast& Delegate) { Delegate.AddWeak(WeakListener, &FListener::Update); });
+        RunMulticastBind("Lambda", [&](FMulticast& Delegate) { Delegate.AddLambda([&Listener](int A, int B, int C) { Listener.Update(A, B, C); }); });
+
+        Runner.Run("Bind/std::vector<std::function>/Lambda", NumBinds, [&](uint64_t NumOps)
+            {
+                FFunctionVector Functions;
+                for (uint64_t Op = 0; Op < NumOps; ++Op)
+                {
+                    Functions.emplace_back([&Listener](int A, int B, int C) { Listener.Update(A, B, C); });
+                    if ((Op + 1) % NumPerDelegate == 0)
+                    {
+                        Runner.PauseTiming();
+                        Functions.clear();
+                        Runner.ResumeTiming();
+                    }
+                }
+            });
+    }
+
+    // ======================= Broadcast =======================
+
+    void RunBroadcastBenchmarks(FBenchmarkRunner& Runner)
+    {
+        for (const size_t NumListeners : ListenerCounts)
+        {
+            const uint64_t NumBroadcasts = GetNumBroadcasts(NumListeners);
+            const uint64_t NumCalls = NumBroadcasts * NumListeners;
+
+            std::vector<FListener> Listeners(NumListeners);
+            std::vector<std::shared_ptr<FListener>> SharedListeners;
+            for (size_t Index = 0; Index < NumListeners; ++Index) SharedListeners.push_back(std::make_shared<FListener>());
+
+            // Every benchmark reports nanoseconds per listener call.
+            const auto RunBroadcast = [&](const char* InVariant, auto& InDelegate)
+                {
+                    Runner.Run(MakeName("Broadcast", InVariant, NumListeners), NumCalls, [&](uint64_t)
+                        {
+                            for (uint64_t Broadcast = 0; Broadcast < NumBroadcasts; ++Broadcast) InDelegate.Broadcast(100, static_cast<int>(Broadcast), -1);
+                        });
+                };
+
+            if (Runner.ShouldRun(MakeName("Broadcast", "TMulticastDelegate/Raw", NumListeners)))
+            {
+                FMulticast Delegate;
+                for (FListener& Listener : Listeners) Delegate.AddRaw(&Listener, &FListener::Update);
+                RunBroadcast("TMulticastDelegate/Raw", Delegate);
+            }
+
+            if (Runner.ShouldRun(MakeName("Broadcast", "TMulticastDelegate/Weak", NumListeners)))
+            {
+                FMulticast Delegate;
+                for (const auto& Listener : SharedListeners) Delegate.AddWeak(std::weak_ptr<FListener>(Listener), &FListener::Update);
+                RunBroadcast("TMulticastDelegate/Weak", Delegate);
+            }
+
+            if (Runner.ShouldRun(MakeName("Broadcast", "TMulticastDelegate/WeakPinned", NumListeners)))
+            {
+                FMulticast Delegate;
+                for (const auto& Listener : SharedListeners) Delegate.AddWeak(std::weak_ptr<FListener>(Listener), &FListener::Update);
+
+                FMulticast::FWeakPinScope Pin(Delegate);
+                RunBroadcast("TMulticastDelegate/WeakPinned", Delegate);
+            }
+
+            if (Runner.ShouldRun(MakeName("Broadcast", "TMulticastDelegate/Lambda", NumListeners)))
+            {
+                FMulticast Delegate;
+                for (FListener& Listener : Listeners) Delegate.AddLambda([&Listener](int A, int B, int C) { Listener.Update(A, B, C); });
+                RunBroadcast("TMulticastDelegate/Lambda", Delegate);
+            }
+
+            if (Runner.ShouldRun(MakeName("Broadcast", "TThreadSafeMulticastDelegate/Raw", NumListeners)))
+            {
+                FThreadSafeMulticast Delegate;
+                for (FListener& Listener : Listeners) Delegate.AddRaw(&Listener, &FListener::Update);
+                RunBroadcast("TThreadSafeMulticastDelegate/Raw", Delegate);
+            }
+
+            if (Runner.ShouldRun(MakeName("Broadcast", "std::vector<std::function>", NumListeners)))
+            {
+                FFunctionVector Functions;
+                for (FListener& Listener : Listeners) Functions.emplace_back([&Listener](int A, int B, int C) { Listener.Update(A, B, C); });
+
+                Runner.Run(MakeName("Broadcast", "std::vector<std::function>", NumListeners), NumCalls, [&](uint64_t)
+                    {
+                        for (uint64_t Broadcast = 0; Broadcast < NumBroadcasts; ++Broadcast)
+                        {
+                            for (const auto& Function : Functions) Function(100, static_cast<int>(Broadcast), -1);
+                        }
+                    });
+            }
+
+            uint64_t Checksum = 0;
+            for (const FListener& Listener : Listeners) Checksum += Listener.Sum;
+            DoNotOptimize(Checksum);
+        }
+
+        // The listener set of a static delegate is fixed at compile time, so it is only measured at its own size.
+        {
+            using FStaticMulticast = Delegates::TStaticMulticastDelegate<FSignal, &FListener::Update, &FOtherListener::Update>;
+
+            FListener Listener;
+            FOtherListener OtherListener;
+            FStaticMulticast Delegate;
+            Delegate.AddRaw(&Listener, &FListener::Update);
+            Delegate.AddRaw(&OtherListener, &FOtherListener::Update);
+
+            FMulticast DynamicDelegate;
+            DynamicDelegate.AddRaw(&Listener, &FListener::Update);
+            DynamicDelegate.AddRaw(&OtherListener, &FOtherListener::Update);
+
+            constexpr uint64_t NumBroadcasts = 1'000'000;
+            // The listeners are inlined here, so they are escaped every broadcast to keep their work observable.
+            Runner.Run("Broadcast/TStaticMulticastDelegate/2", NumBroadcasts * 2, [&](uint64_t)
+                {
+                    for (uint64_t Broadcast = 0; Broadcast < NumBroadcasts; ++Broadcast)
+                    {
+                        Delegate.Broadcast(100, static_cast<int>(Broadcast), -1);
+                        DoNotOptimize(Listener);
+                        DoNotOptimize(OtherListener);
+                    }
+                });
+            Runner.Run("Broadcast/TMulticastDelegate/Raw/2", NumBroadcasts * 2, [&](uint64_t)
+                {
+                    for (uint64_t Broadcast = 0; Broadcast < NumBroadcasts; ++Broadcast)
+                    {
+                        DynamicDelegate.Broadcast(100, static_cast<int>(Broadcast), -1);
+                        DoNotOptimize(Listener);
+                        DoNotOptimize(OtherListener);
+                    }
+                });
+
+            DoNotOptimize(Listener.Sum + OtherListener.Sum);
+        }
+
+        // A move-only argument reaches every listener as the same rvalue reference, without a copy; here the first
+        // listener reads the payload and the last takes it back, so the same one is handed around every broadcast.
+        {
+            Delegates::TMulticastDelegate<void(std::unique_ptr<FListener>)> Delegate;
+            std::unique_ptr<FListener> Payload = std::make_unique<FListener>();
+            uint64_t Sum = 0;
+
+            Delegate.AddLambda([&Sum](std::unique_ptr<FListener>&& InPayload) { Sum += InPayload->Sum++; });
+            Delegate.AddLambda([&Payload](std::unique_ptr<FListener>&& InPayload) { Payload = std::move(InPayload); });
+
+            constexpr uint64_t NumBroadcasts = 1'000'000;
+            Runner.Run("Broadcast/TMulticastDelegate/MoveOnlyArg/2", NumBroadcasts * 2, [&](uint64_t)
+                {
+                    for (uint64_t Broadcast = 0; Broadcast < NumBroadcasts; ++Broadcast) Delegate.Broadcast(std::move(Payload));
+                });
+
+            DoNotOptimize(Sum);
+        }
+    }
+
+    // ======================= Await =======================
+
+    // Minimal coroutine owner: starts eagerly and is destroyed with the object.
+    struct FAwaitTask
+    {
+        struct promise_type
+        {
+            FAwaitTask get_return_object() { return FAwaitTask{ std::coroutine_handle<promise_type>::from_promise(*this) }; }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+        };
+
+        explicit FAwaitTask(std::coroutine_handle<promise_type> InHandle) : Handle(InHandle) {}
+        FAwaitTask(const FAwaitTask&) = delete;
+        ~FAwaitTask() { Handle.destroy(); }
+
+        std::coroutine_handle<promise_type> Handle;
+    };
+
+    FAwaitTask AwaitForever(FMulticast& InDelegate, uint64_t& OutSum)
+    {
+        for (;;)
+        {
+            const auto [MaxHealth, Health, Delta] = co_await InDelegate.Next();
+            OutSum += static_cast<uint64_t>(MaxHealth + Health + Delta);
+        }
+    }
+
+    // One wait per op: a coroutine awaiting Next() against the one-shot lambda it replaces, which carries its state
+    // and removes itself once it fires.
+    void RunAwaitBenchmarks(FBenchmarkRunner& Runner)
+    {
+        constexpr uint64_t NumWaits = 1'000'000;
+
+        {
+            FMulticast Delegate;
+            uint64_t Sum = 0;
+            FAwaitTask Task = AwaitForever(Delegate, Sum);
+
+            Runner.Run("Await/TMulticastDelegate/Next", NumWaits, [&](uint64_t)
+                {
+                    for (uint64_t Wait = 0; Wait < NumWaits; ++Wait) Delegate.Broadcast(100, static_cast<int>(Wait), -1);
+                });
+            DoNotOptimize(Sum);
+        }
+
+        {
+            FMulticast Delegate;
+            uint64_t Sum = 0;
+
+            Runner.Run("Await/TMulticastDelegate/AddLambdaRemove", NumWaits, [&](uint64_t)
+                {
+                    for (uint64_t Wait = 0; Wait < NumWaits; ++Wait)
+                    {
+                        auto Handle = std::make_shared<Delegates::FDelegateHandle>();
+                        *Handle = Delegate.AddLambda([&Delegate, &Sum, Handle](int MaxHealth, int Health, int Delta)
+                            {
+                                Sum += static_cast<uint64_t>(MaxHealth + Health + Delta);
+                                Delegate.Remove(*Handle);
+                            });
+                        Delegate.Broadcast(100, static_cast<int>(Wait), -1);
+                    }
+                });
+            DoNotOptimize(Sum);
+        }
+    }
+
+    // ======================= Execute =======================
+
+    void RunExecuteBenchmarks(FBenchmarkRunner& Runner)
+    {
+        constexpr uint64_t NumCalls = 10'000'000;
+
+        FListener Listener;
+
+        // Each delegate is escaped once, so the call cannot be devirtualized or inlined through a known target.
+        auto RunExecute = [&](const char* InName, const auto& InDelegate)
+            {
+                DoNotOptimize(InDelegate);
+                Runner.Run(InName, NumCalls, [&](uint64_t)
+                    {
+                        for (uint64_t Call = 0; Call < NumCalls; ++Call) InDelegate.Execute(100, static_cast<int>(Call), -1);
+                        DoNotOptimize(Listener);
+                    });
+            };
+
+        FUnicast Unicast;
+        Unicast.AddRaw(&Listener, &FListener::Update);
+        RunExecute("Execute/TDelegate/Raw", Unicast);
+
+        FFastUnicast FastRaw;
+        FastRaw.BindRaw<&FListener::Update>(&Listener);
+        RunExecute("Execute/TFastDelegate/Raw", FastRaw);
+
+        FFastUnicast FastStatic;
+        FastStatic.BindStatic<&StaticListener>();
+        RunExecute("Execute/TFastDelegate/Static", FastStatic);
+
+        const std::function<FSignal> Function = [&Listener](int MaxHealth, int Health, int Delta) { Listener.Update(MaxHealth, Health, Delta); };
+        Runner.Run("Execute/std::function/Lambda", NumCalls, [&](uint64_t)
+            {
+                DoNotOptimize(Function);
+                for (uint64_t Call = 0; Call < NumCalls; ++Call) Function(100, static_cast<int>(Call), -1);
+                DoNotOptimize(Listener);
+            });
+
+        DoNotOptimize(Listener.Sum + GStaticSum);
+    }
+
+    // ======================= Reduce =======================
+
+    struct FModifier
+    {
+        float Modify(int Damage) { return Scale * static_cast<float>(Damage); }
+        bool Veto(int Damage) { return Damage > Threshold; }
+
+        float Scale = 0.5f;
+        int Threshold = 1000;
+    };
+
+    void RunReduceBenchmarks(FBenchmarkRunner& Runner)
+    {
+        for (const size_t NumListeners : { size_t(10), size_t(100), size_t(1000), size_t(10000) })
+        {
+            const uint64_t NumBroadcasts = GetNumBroadcasts(NumListeners);
+            const uint64_t NumCalls = NumBroadcasts * NumListeners;
+
+            std::vector<FModifier> Modifiers(NumListeners);
+
+            if (Runner.ShouldRun(MakeName("Reduce", "TMulticastDelegate/Sum", NumListeners)))
+            {
+                Delegates::TMulticastDelegate<float(int)> Delegate;
+                for (FModifier& Modifier : Modifiers) Delegate.AddRaw(&Modifier, &FModifier::Modify);
+
+                Runner.Run(MakeName("Reduce", "TMulticastDelegate/Sum", NumListeners), NumCalls, [&](uint64_t)
+                    {
+                        for (uint64_t Broadcast = 0; Broadcast < NumBroadcasts; ++Broadcast)
+                        {
+                            const float Sum = Delegate.BroadcastReduce([](float InSum, float InValue) { return InSum + InValue; }, 0.0f, static_cast<int>(Broadcast));
+                            DoNotOptimize(Sum);
+                        }
+                    });
+            }
+
+            // Baseline: what callers did before BroadcastReduce, collecting into a vector from lambdas.
+            if (Runner.ShouldRun(MakeName("Reduce", "std::vector<std::function>/CollectSum", NumListeners)))
+            {
+                std::vector<float> Values;
+                std::vector<std::function<void(int)>> Functions;
+                for (FModifier& Modifier : Modifiers) Functions.emplace_back([&Values, &Modifier](int InDamage) { Values.push_back(Modifier.Modify(InDamage)); });
+
+                Runner.Run(MakeName("Reduce", "std::vector<std::function>/CollectSum", NumListeners), NumCalls, [&](uint64_t)
+                    {
+                        for (uint64_t Broadcast = 0; Broadcast < NumBroadcasts; ++Broadcast)
+                        {
+                            std::vector<float>().swap(Values);
+                            for (const auto& Function : Functions) Function(static_cast<int>(Broadcast));
+                            const float Sum = std::accumulate(Values.begin(), Values.end(), 0.0f);
+                            DoNotOptimize(Sum);
+                        }
+                    });
+            }
+
+            // The middle listener vetoes, so half of them are never called. Reported per bound listener.
+            if (Runner.ShouldRun(MakeName("Reduce", "TMulticastDelegate/AnyTrue", NumListeners)))
+            {
+                Delegates::TMulticastDelegate<bool(int)> Delegate;
+                Modifiers[NumListeners / 2].Threshold = -1;
+                for (FModifier& Modifier : Modifiers) Delegate.AddRaw(&Modifier, &FModifier::Veto);
+
+                Runner.Run(MakeName("Reduce", "TMulticastDelegate/AnyTrue", NumListeners), NumCalls, [&](uint64_t)
+                    {
+                        for (uint64_t Broadcast = 0; Broadcast < NumBroadcasts; ++Broadcast)
+                        {
+                            const bool bVetoed = Delegate.BroadcastAnyTrue(static_cast<int>(Broadcast % 1000));
+                            DoNotOptimize(bVetoed);
+                        }
+                    });
+            }
+        }
+    }
+
+    // ======================= Filter =======================
+
+    // Every entity listens for damage, but each event hits one of them.
+    struct FDamageable
+    {
+        void OnDamaged(uint32_t InEntityID, int InDamage)
+        {
+            if (InEntityID != EntityID) return;
+            Health -= InDamage;
+        }
+
+        uint32_t EntityID = 0;
+        int Health = 100;
+    };
+
+    void RunFilterBenchmarks(FBenchmarkRunner& Runner)
+    {
+        for (const size_t NumListeners : { size_t(100), size_t(1000), size_t(10000), size_t(100000) })
+        {
+            const uint64_t NumBroadcasts = GetNumBroadcasts(NumListeners);
+            const uint64_t NumCalls = NumBroadcasts * NumListeners;
+
+            std::vector<FDamageable> Entities(NumListeners);
+            for (size_t Index = 0; Index < NumListeners; ++Index) Entities[Index].EntityID = static_cast<uint32_t>(Index);
+
+            // Listeners check the ID themselves, so every one of them is called.
+            Delegates::TMulticastDelegate<void(uint32_t, int)> Unfiltered;
+            for (FDamageable& Entity : Entities) Unfiltered.AddRaw(&Entity, &FDamageable::OnDamaged);
+
+            Runner.Run(MakeName("Filter", "TMulticastDelegate/ListenerChecksID", NumListeners), NumCalls, [&](uint64_t)
+                {
+                    for (uint64_t Broadcast = 0; Broadcast < NumBroadcasts; ++Broadcast)
+                    {
+                        const uint32_t Target = static_cast<uint32_t>(Broadcast % NumListeners);
+                        Unfiltered.Broadcast(Target, 1);
+                    }
+                });
+
+            Delegates::TMulticastDelegate<void(uint32_t, int)> Filtered;
+            for (FDamageable& Entity : Entities) Filtered.AddRaw(&Entity, &FDamageable::OnDamaged, Delegates::FDelegateBindOptions().Filtered(Entity.EntityID));
+
+            Runner.Run(MakeName("Filter", "TMulticastDelegate/BroadcastKeyed", NumListeners), NumCalls, [&](uint64_t)
+                {
+                    for (uint64_t Broadcast = 0; Broadcast < NumBroadcasts; ++Broadcast)
+                    {
+                        const uint32_t Target = static_cast<uint32_t>(Broadcast % NumListeners);
+                        Filtered.BroadcastKeyed(Target, Target, 1);
+                    }
+                });
+
+            int Checksum = 0;
+            for (const FDamageable& Entity : Entities) Checksum += Entity.Health;
+            DoNotOptimize(Checksum);
+        }
+    }
+
+    // ======================= Parallel =======================
+
+    // An AI agent reacting to a world event: a few hundred nanoseconds of independent work per listener.
+    struct FAgent
+    {
+        void React(int MaxHealth, int Health, int Delta)
+        {
+            uint64_t Value = State + static_cast<uint64_t>(MaxHealth + Health + Delta);
+            for (int Step = 0; Step < 64; ++Step) Value = Value * 6364136223846793005ull + 1442695040888963407ull;
+            State = Value;
+        }
+
+        // Own cache line, so agents updated on different workers don't share one.
+        alignas(64) uint64_t State = 0;
+    };
+
+    void RunParallelBenchmarks(FBenchmarkRunner& Runner)
+    {
+        Delegates::FWorkStealingExecutor Executor;
+
+        for (const size_t NumListeners : { size_t(100), size_t(1000), size_t(10000), size_t(100000) })
+        {
+            const uint64_t NumBroadcasts = std::max<uint64_t>(1, 200'000 / NumListeners);
+            const uint64_t NumCalls = NumBroadcasts * NumListeners;
+
+            std::vector<FAgent> Agents(NumListeners);
+
+            FMulticast Delegate;
+            for (FAgent& Agent : Agents) Delegate.AddRaw(&Agent, &FAgent::React, Delegates::FDelegateBindOptions::AnyThread());
+
+            Runner.Run(MakeName("Broadcast", "TMulticastDelegate/Agents/Sequential", NumListeners), NumCalls, [&](uint64_t)
+                {
+                    for (uint64_t Broadcast = 0; Broadcast < NumBroadcasts; ++Broadcast) Delegate.Broadcast(100, static_cast<int>(Broadcast), -1);
+                }, 3);
+
+            const std::string ParallelName = "TMulticastDelegate/Agents/Parallel/" + std::to_string(Executor.GetNumWorkers() + 1) + "Threads";
+            Runner.Run(MakeName("Broadcast", ParallelName.c_str(), NumListeners), NumCalls, [&](uint64_t)
+                {
+                    for (uint64_t Broadcast = 0; Broadcast < NumBroadcasts; ++Broadcast) Delegate.ParallelBroadcast(Executor, 100, static_cast<int>(Broadcast), -1);
+                }, 3);
+
+            uint64_t Checksum = 0;
+            for (const FAgent& Agent : Agents) Checksum += Agent.State;
+            DoNotOptimize(Checksum);
+        }
+    }
+
+    // ======================= Sharded =======================
+
+    // A global event with a very large audience, in one listener array against shards of 1024.
+    void RunShardedBenchmarks(FBenchmarkRunner& Runner)
+    {
+        std::mt19937 Random(1234);
+
+        const auto RunVariant = [&](const char* InVariant, size_t InNumListeners, auto InDelegateTag)
+            {
+                using FDelegateType = typename decltype(InDelegateTag)::type;
+
+                std::vector<FListener> Listeners(InNumListeners);
+
+                Runner.Run(MakeName("Add", InVariant, InNumListeners), InNumListeners, [&](uint64_t)
+                    {
+                        Runner.PauseTiming();
+                        auto Delegate = std::make_unique<FDelegateType>();
+                        Runner.ResumeTiming();
+
+                        for (FListener& Listener : Listeners) Delegate->AddRaw(&Listener, &FListener::Update);
+
+                        Runner.PauseTiming();
+                        DoNotOptimize(*Delegate);
+                        Delegate.reset();
+                        Runner.ResumeTiming();
+                    }, 3);
+
+                FDelegateType Delegate;
+                std::vector<Delegates::FDelegateHandle> Handles;
+                for (FListener& Listener : Listeners) Handles.push_back(Delegate.AddRaw(&Listener, &FListener::Update));
+
+                const uint64_t NumBroadcasts = GetNumBroadcasts(InNumListeners);
+                Runner.Run(MakeName("Broadcast", InVariant, InNumListeners), NumBroadcasts * InNumListeners, [&](uint64_t)
+                    {
+                        for (uint64_t Broadcast = 0; Broadcast < NumBroadcasts; ++Broadcast) Delegate.Broadcast(100, static_cast<int>(Broadcast), -1);
+                    });
+
+                // A tenth of the listeners leave in random order, each followed by a rejoin, as players come and go.
+                std::shuffle(Handles.begin(), Handles.end(), Random);
+                const size_t NumChurned = InNumListeners / 10;
+                Runner.Run(MakeName("Churn", InVariant, InNumListeners), NumChurned, [&](uint64_t)
+                    {
+                        for (size_t Index = 0; Index < NumChurned; ++Index)
+                        {
+                            Delegate.Remove(Handles[Index]);
+                            Handles[Index] = Delegate.AddRaw(&Listeners[Index], &FListener::Update);
+                        }
+                    }, 3);
+            };
+
+        for (const size_t NumListeners : { size_t(10000), size_t(100000), size_t(1000000) })
+        {
+            RunVariant("TMulticastDelegate", NumListeners, std::type_identity<FMulticast>());
+            RunVariant("TShardedMulticastDelegate", NumListeners, std::type_identity<FShardedMulticast>());
+        }
+    }
+
+    // ======================= Marshal =======================
+
+    // A hit event too large to share a mailbox cell with the listener, so marshalling it boxes the arguments.
+    struct FHitEvent
+    {
+        float Location[3] = {};
+        float Normal[3] = {};
+        float Impulse[3] = {};
+        int Damage = 0;
+        uint64_t Instigator = 0;
+        uint64_t Victim = 0;
+        uint64_t Flags = 0;
+    };
+    static_assert(sizeof(FHitEvent) > Delegates::FDelegateMailbox::MaxMessageSize);
+
+    struct FHitListener
+    {
+        void OnHit(const FHitEvent& Hit) { Sum += static_cast<uint64_t>(Hit.Damage); }
+
+        uint64_t Sum = 0;
+    };
+
+    // One producer thread broadcasts NumMessages times while this thread pumps the mailbox. InBroadcast returns how
+    // many of its posts were dropped.
+    template <typename BroadcastFunc>
+    void RunMailboxMarshal(FBenchmarkRunner& Runner, const std::string& InName, uint64_t NumMessages, Delegates::FDelegateMailbox& Mailbox, BroadcastFunc&& InBroadcast)
+    {
+        Runner.Run(InName, NumMessages, [&](uint64_t)
+            {
+                std::atomic<bool> bDone{ false };
+                std::thread Producer([&]
+                    {
+                        for (uint64_t Message = 0; Message < NumMessages; ++Message)
+                        {
+                            // Posting never waits: a full ring drops, so the producer backs off until there is room.
+                            if (InBroadcast(Message) != 0) { --Message; std::this_thread::yield(); }
+                        }
+                        bDone.store(true, std::memory_order_release);
+                    });
+
+                // Both consumers yield when they find nothing, so a producer sharing their core gets to run.
+                while (!bDone.load(std::memory_order_acquire))
+                {
+                    if (Mailbox.Pump() == 0) std::this_thread::yield();
+                }
+                Mailbox.Pump();
+                Producer.join();
+            });
+    }
+
+    // The mailbox against what listeners used to do to reach the game thread: push a std::function onto a locked queue.
+    void RunMarshalBenchmarks(FBenchmarkRunner& Runner)
+    {
+        constexpr uint64_t NumMessages = 1'000'000;
+
+        {
+            Delegates::FDelegateMailbox Mailbox(4096);
+            FThreadSafeMulticast Delegate;
+            FListener Listener;
+            Delegate.AddRaw(&Listener, &FListener::Update, &Mailbox);
+
+            RunMailboxMarshal(Runner, "Marshal/TThreadSafeMulticastDelegate/Mailbox", NumMessages, Mailbox,
+                [&](uint64_t Message) { return Delegate.Broadcast(100, static_cast<int>(Message), -1); });
+            DoNotOptimize(Listener.Sum);
+        }
+
+        {
+            Delegates::FDelegateMailbox Mailbox(4096);
+            Delegates::TThreadSafeMulticastDelegate<void(const FHitEvent&)> Delegate;
+            FHitListener Listener;
+            Delegate.AddRaw(&Listener, &FHitListener::OnHit, &Mailbox);
+
+            RunMailboxMarshal(Runner, "Marshal/TThreadSafeMulticastDelegate/Mailbox/BoxedHitEvent", NumMessages, Mailbox, [&](uint64_t Message)
+                {
+                    FHitEvent Hit;
+                    Hit.Damage = static_cast<int>(Message & 0xff);
+                    return Delegate.Broadcast(Hit);
+                });
+            DoNotOptimize(Listener.Sum);
+        }
+
+        {
+            std::mutex Mutex;
+            std::deque<std::function<void()>> Queue;
+            FListener Listener;
+
+            Runner.Run("Marshal/std::mutex+std::deque<std::function>", NumMessages, [&](uint64_t)
+                {
+                    std::atomic<bool> bDone{ false };
+                    std::thread Producer([&]
+                        {
+                            for (uint64_t Message = 0; Message < NumMessages; ++Message)
+                            {
+                                std::lock_guard<std::mutex> Lock(Mutex);
+                                Queue.emplace_back([&Listener, Message] { Listener.Update(100, static_cast<int>(Message), -1); });
+                            }
+                            bDone.store(true, std::memory_order_release);
+                        });
+
+                    std::deque<std::function<void()>> Draining;
+                    for (bool bLast = false; !bLast;)
+                    {
+                        bLast = bDone.load(std::memory_order_acquire);
+                        {
+                            std::lock_guard<std::mutex> Lock(Mutex);
+                            std::swap(Queue, Draining);
+                        }
+                        if (Draining.empty()) std::this_thread::yield();
+                        for (std::function<void()>& Call : Draining) Call();
+                        Draining.clear();
+                    }
+                    Producer.join();
+                });
+            DoNotOptimize(Listener.Sum);
+        }
+    }
+
+    // ======================= Remove =======================
+
+    void RunRemoveBenchmarks(FBenchmarkRunner& Runner)
+    {
+        std::mt19937 Random(1234);
+
+        for (const size_t NumListeners : { size_t(100), size_t(1000), size_t(10000), size_t(100000) })
+        {
+            std::vector<FListener> Listeners(NumListeners);
+
+            // Removes every binding by handle, in random order.
+            Runner.Run(MakeName("Remove", "TMulticastDelegate/Handle", NumListeners), NumListeners, [&](uint64_t)
+                {
+                    Runner.PauseTiming();
+                    FMulticast Delegate;
+                    std::vector<Delegates::FDelegateHandle> Handles;
+                    for (FListener& Listener : Listeners) Handles.push_back(Delegate.AddRaw(&Listener, &FListener::Update));
+                    std::shuffle(Handles.begin(), Handles.end(), Random);
+                    Runner.ResumeTiming();
+
+                    for (const Delegates::FDelegateHandle& Handle : Handles) Delegate.Remove(Handle);
+
+                    Runner.PauseTiming();
+                    DoNotOptimize(Delegate);
+                    Runner.ResumeTiming();
+                }, 3);
+
+            // Same, unbinding through scoped handles going out of scope.
+            Runner.Run(MakeName("Remove", "TMulticastDelegate/ScopedHandle", NumListeners), NumListeners, [&](uint64_t)
+                {
+                    Runner.PauseTiming();
+                    FMulticast Delegate;
+                    std::vector<FMulticast::FScopedHandle> Handles;
+                    for (FListener& Listener : Listeners) Handles.push_back(Delegate.AddScopedRaw(&Listener, &FListener::Update));
+                    std::shuffle(Handles.begin(), Handles.end(), Random);
+                    Runner.ResumeTiming();
+
+                    for (FMulticast::FScopedHandle& Handle : Handles) Handle.Reset();
+
+                    Runner.PauseTiming();
+                    DoNotOptimize(Delegate);
+                    Handles.clear();
+                    Runner.ResumeTiming();
+                }, 3);
+
+            // Baseline: id-tagged std::function vector, find + erase.
+            if (NumListeners <= 10000)
+            {
+                Runner.Run(MakeName("Remove", "std::vector<std::function>/FindErase", NumListeners), NumListeners, [&](uint64_t)
+                    {
+                        Runner.PauseTiming();
+                        std::vector<std::pair<size_t, std::function<FSignal>>> Functions;
+                        std::vector<size_t> Ids(NumListeners);
+                        for (size_t Index = 0; Index < NumListeners; ++Index)
+                        {
+                            FListener* Listener = &Listeners[Index];
+                            Functions.emplace_back(Index, [Listener](int A, int B, int C) { Listener->Update(A, B, C); });
+                        }
+                        std::iota(Ids.begin(), Ids.end(), size_t(0));
+                        std::shuffle(Ids.begin(), Ids.end(), Random);
+                        Runner.ResumeTiming();
+
+                        for (const size_t Id : Ids)
+                        {
+                            auto Iter = std::find_if(Functions.begin(), Functions.end(), [&](const auto& Entry) { return Entry.first == Id; });
+                            if (Iter != Functions.end()) Functions.erase(Iter);
+                        }
+                    }, 3);
+            }
+
+            // Ten bindings per owner, removed one owner at a time.
+            constexpr size_t BindingsPerOwner = 10;
+            const size_t NumOwners = NumListeners / BindingsPerOwner;
+
+            Runner.Run(MakeName("RemoveAll", "TMulticastDelegate/Owner", NumListeners), NumOwners, [&](uint64_t)
+                {
+                    Runner.PauseTiming();
+                    FMulticast Delegate;
+                    for (size_t Index = 0; Index < NumListeners; ++Index)
+                    {
+                        Delegate.AddRaw(&Listeners[Index % NumOwners], &FListener::Update);
+                    }
+                    Runner.ResumeTiming();
+
+                    for (size_t Owner = 0; Owner < NumOwners; ++Owner) Delegate.RemoveAll(&Listeners[Owner]);
+
+                    Runner.PauseTiming();
+                    DoNotOptimize(Delegate);
+                    Runner.ResumeTiming();
+                }, NumListeners >= 100000 ? 1 : 3);
+
+            // Actor teardown: one owner's lambdas leave a delegate that everyone else keeps listening on.
+            Runner.Run(MakeName("RemoveAll", "TMulticastDelegate/OneOwnerLambda", NumListeners), BindingsPerOwner, [&](uint64_t)
+                {
+                    Runner.PauseTiming();
+                    auto Delegate = std::make_unique<FMulticast>();
+                    for (size_t Index = 0; Index < NumListeners; ++Index)
+                    {
+                        FListener* Listener = &Listeners[Index % NumOwners];
+                        Delegate->AddLambda(Listener, [Listener](int A, int B, int C) { Listener->Update(A, B, C); });
+                    }
+                    Runner.ResumeTiming();
+
+                    Delegate->RemoveAll(&Listeners[NumOwners / 2]);
+
+                    // Keep tearing down the other listeners out of the measurement.
+                    Runner.PauseTiming();
+                    DoNotOptimize(*Delegate);
+                    Delegate.reset();
+                    Runner.ResumeTiming();
+                }, NumListeners >= 100000 ? 1 : 3);
+        }
+    }
+
+    // ======================= Reentrancy & Compaction =======================
+
+    struct FChurnListener
+    {
+        void Update(int MaxHealth, int Health, int Delta)
+        {
+            Sum += static_cast<uint64_t>(MaxHealth + Health + Delta);
+
+            // Every tenth call re-binds this listener, which moves it behind the pending adds of the running broadcast.
+            if (++Calls % 10 != 0) return;
+
+            Delegate->Remove(Handle);
+            Handle = Delegate->AddRaw(this, &FChurnListener::Update);
+        }
+
+        FMulticast* Delegate = nullptr;
+        Delegates::FDelegateHandle Handle;
+        uint64_t Sum = 0;
+        uint64_t Calls = 0;
+    };
+
+    void RunReentrancyBenchmarks(FBenchmarkRunner& Runner)
+    {
+        for (const size_t NumListeners : { size_t(100), size_t(1000), size_t(10000) })
+        {
+            const uint64_t NumBroadcasts = GetNumBroadcasts(NumListeners);
+
+            FMulticast Delegate;
+            std::vector<FChurnListener> Listeners(NumListeners);
+            for (FChurnListener& Listener : Listeners)
+            {
+                Listener.Delegate = &Delegate;
+                Listener.Handle = Delegate.AddRaw(&Listener, &FChurnListener::Update);
+            }
+
+            Runner.Run(MakeName("Broadcast", "TMulticastDelegate/Reentrant/RebindEveryTenth", NumListeners), NumBroadcasts * NumListeners, [&](uint64_t)
+                {
+                    for (uint64_t Broadcast = 0; Broadcast < NumBroadcasts; ++Broadcast) Delegate.Broadcast(100, static_cast<int>(Broadcast), -1);
+                });
+
+            // Nested broadcasts: every listener of the outer delegate broadcasts an inner one.
+            FMulticast Inner;
+            std::vector<FListener> InnerListeners(10);
+            for (FListener& Listener : InnerListeners) Inner.AddRaw(&Listener, &FListener::Update);
+
+            FMulticast Outer;
+            for (size_t Index = 0; Index < NumListeners; ++Index)
+            {
+                Outer.AddLambda([&Inner](int A, int B, int C) { Inner.Broadcast(A, B, C); });
+            }
+
+            const uint64_t NumNestedBroadcasts = std::max<uint64_t>(1, NumBroadcasts / 10);
+            Runner.Run(MakeName("Broadcast", "TMulticastDelegate/Nested/x10", NumListeners), NumNestedBroadcasts * NumListeners, [&](uint64_t)
+                {
+                    for (uint64_t Broadcast = 0; Broadcast < NumNestedBroadcasts; ++Broadcast) Outer.Broadcast(100, static_cast<int>(Broadcast), -1);
+                });
+        }
+
+        for (const size_t NumListeners : { size_t(1000), size_t(10000), size_t(100000) })
+        {
+            // Half of the weak listeners expire; one broadcast finds them and compaction erases them.
+            Runner.Run(MakeName("Compaction", "TMulticastDelegate/WeakExpiry", NumListeners), NumListeners, [&](uint64_t)
+                {
+                    Runner.PauseTiming();
+                    FMulticast Delegate;
+                    std::vector<std::shared_ptr<FListener>> SharedListeners;
+                    for (size_t Index = 0; Index < NumListeners; ++Index)
+                    {
+                        SharedListeners.push_back(std::make_shared<FListener>());
+                        Delegate.AddWeak(std::weak_ptr<FListener>(SharedListeners.back()), &FListener::Update);
+                    }
+                    for (size_t Index = 0; Index < NumListeners; Index += 2) SharedListeners[Index].reset();
+                    Runner.ResumeTiming();
+
+                    Delegate.Broadcast(100, 0, -1);
+                    Delegate.Compact();
+
+                    Runner.PauseTiming();
+                    DoNotOptimize(Delegate);
+                    SharedListeners.clear();
+                    Runner.ResumeTiming();
+                }, 3);
+        }
+    }
+
+    // ======================= Queued =======================
+
+    void RunQueuedBenchmarks(FBenchmarkRunner& Runner)
+    {
+        constexpr size_t NumEvents = 100;
+
+        for (const size_t NumListeners : { size_t(10), size_t(100), size_t(1000) })
+        {
+            FMulticast Delegate;
+            std::vector<FListener> Listeners(NumListeners);
+            for (FListener& Listener : Listeners) Delegate.AddRaw(&Listener, &FListener::Update);
+
+            const uint64_t NumFrames = std::max<uint64_t>(1, GetNumBroadcasts(NumListeners) / NumEvents);
+
+            Runner.Run(MakeName("Flush", "TMulticastDelegate/100Events", NumListeners), NumFrames * NumEvents * NumListeners, [&](uint64_t)
+                {
+                    for (uint64_t Frame = 0; Frame < NumFrames; ++Frame)
+                    {
+                        for (size_t Event = 0; Event < NumEvents; ++Event) Delegate.EnqueueBroadcast(100, static_cast<int>(Event), -1);
+                        Delegate.Flush();
+                    }
+                });
+
+            // The same 100 deltas per frame folded into one event, as a HUD that only shows the latest health would.
+            Runner.Run(MakeName("Flush", "TMulticastDelegate/100Events/Merged", NumListeners), NumFrames * NumEvents * NumListeners, [&](uint64_t)
+                {
+                    for (uint64_t Frame = 0; Frame < NumFrames; ++Frame)
+                    {
+                        for (size_t Event = 0; Event < NumEvents; ++Event)
+                        {
+                            Delegate.EnqueueMerged([](FMulticast::FEventArgs& Pending, FMulticast::FEventArgs&& New)
+                                {
+                                    Pending = { std::get<0>(New), std::get<1>(New), std::get<2>(Pending) + std::get<2>(New) };
+                                }, 100, static_cast<int>(Event), -1);
+                        }
+                        Delegate.Flush();
+                    }
+                });
+        }
+    }
+}
+
+// Usage: DelegateBenchmarks [filter]. Only benchmarks whose name contains the filter are run.
+int main(int argc, char* argv[])
+{
+    FBenchmarkRunner Runner(argc > 1 ? argv[1] : nullptr);
+
+    RunBindBenchmarks(Runner);
+    RunBroadcastBenchmarks(Runner);
+    RunAwaitBenchmarks(Runner);
+    RunExecuteBenchmarks(Runner);
+    RunReduceBenchmarks(Runner);
+    RunFilterBenchmarks(Runner);
+    RunParallelBenchmarks(Runner);
+    RunShardedBenchmarks(Runner);
+    RunMarshalBenchmarks(Runner);
+    RunRemoveBenchmarks(Runner);
+    RunReentrancyBenchmarks(Runner);
+    RunQueuedBenchmarks(Runner);
+
+    return 0;
+}
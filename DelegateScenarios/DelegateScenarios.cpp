@@ -0,0 +1,506 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BenchmarkHarness.h"
+#include "DelegateInstance.h"
+#include "ThreadSafeMulticastDelegate.h"
+
+BENCHMARK_DEFINE_ALLOCATION_COUNTING()
+
+// The Entity/Logger/HUD demo grown into a world of entities whose health events churn their own listener lists:
+// listeners unbind themselves, bind new listeners and destroy the owners of weak listeners from inside Broadcast.
+// Each frame applies a burst of hits to random entities and respawns the ones that died. Every variant runs the same
+// seeded frames; the report gives frame-time percentiles, allocations per frame and the number of broken guarantees
+// (a listener called after its removal, by the broadcast that added it, or through an expired weak pointer; or a
+// listener call lost).
+namespace
+{
+    using FSignal = void(int, int, int);
+
+    using Delegates::FDelegateHandle;
+
+    // ======================= Snapshot Baseline =======================
+
+    // Broadcast as it was before listeners were iterated in place: every call copies the array of shared listeners, so
+    // adds and removes made by listeners touch only the original. A listener removed mid-broadcast is skipped.
+    class FSnapshotMulticastDelegate
+    {
+        struct FEntry
+        {
+            FDelegateHandle Handle;
+            const void* Owner = nullptr;
+            // Returns false once the listener's weak object expired.
+            std::function<bool(int, int, int)> Call;
+            bool bRemoved = false;
+        };
+
+    public:
+        template <typename Class>
+        FDelegateHandle AddRaw(Class* InObjPtr, void (Class::*InMethod)(int, int, int))
+        {
+            return AddInternal(InObjPtr, [InObjPtr, InMethod](int A, int B, int C) { (InObjPtr->*InMethod)(A, B, C); return true; });
+        }
+
+        template <typename Class>
+        FDelegateHandle AddWeak(std::weak_ptr<Class> InWeak, void (Class::*InMethod)(int, int, int))
+        {
+            const void* Owner = InWeak.lock().get();
+            return AddInternal(Owner, [Weak = std::move(InWeak), InMethod](int A, int B, int C)
+                {
+                    const std::shared_ptr<Class> Pinned = Weak.lock();
+                    if (!Pinned) return false;
+
+                    (Pinned.get()->*InMethod)(A, B, C);
+                    return true;
+                });
+        }
+
+        template <typename Func>
+        FDelegateHandle AddLambda(Func&& InFunc)
+        {
+            return AddInternal(nullptr, [Fn = std::forward<Func>(InFunc)](int A, int B, int C) { Fn(A, B, C); return true; });
+        }
+
+        void Remove(FDelegateHandle InHandle)
+        {
+            RemoveIf([&](const FEntry& Entry) { return Entry.Handle == InHandle; });
+        }
+
+        void RemoveAll(const void* InOwner)
+        {
+            if (!InOwner) return;
+
+            RemoveIf([&](const FEntry& Entry) { return Entry.Owner == InOwner; });
+        }
+
+        void Broadcast(int MaxHealth, int Health, int Delta)
+        {
+            if (Entries.empty()) return;
+
+            const auto Snapshot = Entries;
+
+            bool bAnyExpired = false;
+            for (const auto& Entry : Snapshot)
+            {
+                if (Entry->bRemoved || Entry->Call(MaxHealth, Health, Delta)) continue;
+
+                Entry->bRemoved = true;
+                bAnyExpired = true;
+            }
+
+            if (bAnyExpired) std::erase_if(Entries, [](const auto& Entry) { return Entry->bRemoved; });
+        }
+
+    private:
+        template <typename Func>
+        FDelegateHandle AddInternal(const void* InOwner, Func&& InCall)
+        {
+            auto Entry = std::make_shared<FEntry>();
+            Entry->Handle = FDelegateHandle(FDelegateHandle::GenerateNewHandle);
+            Entry->Owner = InOwner;
+            Entry->Call = std::forward<Func>(InCall);
+
+            Entries.push_back(Entry);
+            return Entry->Handle;
+        }
+
+        template <typename Predicate>
+        void RemoveIf(Predicate&& InPredicate)
+        {
+            std::erase_if(Entries, [&](const std::shared_ptr<FEntry>& Entry)
+                {
+                    if (!InPredicate(*Entry)) return false;
+
+                    Entry->bRemoved = true;
+                    return true;
+                });
+        }
+
+        std::vector<std::shared_ptr<FEntry>> Entries;
+    };
+
+    // ======================= Scenario =======================
+
+    struct FScenarioConfig
+    {
+        size_t NumEntities = 10000;
+        size_t NumFrames = 300;
+        // Frames run before measuring. An entity is hit every few frames, so its listener arrays take a while to reach
+        // their working capacity.
+        size_t NumWarmupFrames = 100;
+        size_t HitsPerFrame = 2000;
+        // One hit in PopupEvery spawns a damage popup listener; the popup unbinds itself on the entity's next event.
+        uint32_t PopupEvery = 4;
+        // One entity in HistoryEvery also gets a lambda capturing enough by value to need heap storage.
+        uint32_t HistoryEvery = 8;
+        uint32_t Seed = 1;
+    };
+
+    struct FScenarioCounters
+    {
+        uint64_t Broadcasts = 0;
+        uint64_t HudCalls = 0;
+        // HUDs their reaper unbound before the broadcast reached them (a respawned entity's HUD is bound after it).
+        uint64_t HudsSkipped = 0;
+        uint64_t StatsCalls = 0;
+        uint64_t WatcherCalls = 0;
+        uint64_t Deaths = 0;
+        uint64_t PopupsSpawned = 0;
+        uint64_t PopupsFired = 0;
+        uint64_t Violations = 0;
+        int64_t Checksum = 0;
+    };
+
+    // Per-entity listeners are first bound in this order, so the reaper runs before the watcher it destroys (a respawn
+    // binds the HUD and a new watcher again, at the end):
+    //   HUD (raw), reaper (raw), stats (small lambda), [history (large lambda)], watcher (weak), popup spawner (raw),
+    //   then any popups (lambdas) the spawner added.
+    template <typename DelegateType>
+    class TEntityWorld
+    {
+        static constexpr int MaxHealth = 100;
+
+        struct FEntity
+        {
+            DelegateType OnHealthChanged;
+            int Health = MaxHealth;
+            bool bDead = false;
+            bool bHudBound = false;
+        };
+
+        struct FHud
+        {
+            void Update(int InMaxHealth, int Health, int Delta)
+            {
+                ++World->Counters.HudCalls;
+                World->Counters.Checksum += InMaxHealth - Health + Delta;
+                if (!World->Entities[Index].bHudBound) ++World->Counters.Violations;
+
+                LastBroadcast = World->BroadcastSerial;
+            }
+
+            TEntityWorld* World = nullptr;
+            uint32_t Index = 0;
+            uint64_t LastBroadcast = 0;
+        };
+
+        // Despawns the entity on lethal damage: unbinds its HUD and destroys its watcher, which this broadcast has not
+        // reached yet, so its weak pointer expires mid-broadcast.
+        struct FReaper
+        {
+            void Update(int, int Health, int)
+            {
+                FEntity& Entity = World->Entities[Index];
+                if (Health > 0 || Entity.bDead) return;
+
+                Entity.bDead = true;
+                Entity.bHudBound = false;
+                ++World->Counters.Deaths;
+                if (World->Huds[Index].LastBroadcast != World->BroadcastSerial) ++World->Counters.HudsSkipped;
+
+                Entity.OnHealthChanged.RemoveAll(&World->Huds[Index]);
+                World->Watchers[Index].reset();
+                World->DeadEntities.push_back(Index);
+            }
+
+            TEntityWorld* World = nullptr;
+            uint32_t Index = 0;
+        };
+
+        struct FWatcher
+        {
+            FWatcher(TEntityWorld* InWorld, uint32_t InIndex) : World(InWorld), Index(InIndex) { World->WatcherAlive[Index] = true; }
+            ~FWatcher() { World->WatcherAlive[Index] = false; }
+
+            void Update(int, int Health, int)
+            {
+                ++World->Counters.WatcherCalls;
+                World->Counters.Checksum += Health;
+                if (!World->WatcherAlive[Index]) ++World->Counters.Violations;
+            }
+
+            TEntityWorld* World = nullptr;
+            uint32_t Index = 0;
+        };
+
+        // Binds a popup to the delegate that is broadcasting; the popup must not be called by that broadcast.
+        struct FPopupSpawner
+        {
+            void Update(int, int, int Delta)
+            {
+                if (Delta >= 0 || ++World->SpawnerCalls % World->Config.PopupEvery != 0) return;
+
+                World->SpawnPopup(Index);
+            }
+
+            TEntityWorld* World = nullptr;
+            uint32_t Index = 0;
+        };
+
+        struct FPopup
+        {
+            FDelegateHandle Handle;
+            uint64_t SpawnedInBroadcast = 0;
+            uint32_t Entity = 0;
+            uint32_t NextFree = UINT32_MAX;
+            bool bActive = false;
+        };
+
+    public:
+        explicit TEntityWorld(const FScenarioConfig& InConfig)
+            : Config(InConfig)
+            , Random(InConfig.Seed)
+            , Entities(InConfig.NumEntities)
+            , Huds(InConfig.NumEntities)
+            , Reapers(InConfig.NumEntities)
+            , Spawners(InConfig.NumEntities)
+            , WatcherAlive(InConfig.NumEntities)
+            , Watchers(InConfig.NumEntities)
+        {
+            for (uint32_t Index = 0; Index < Entities.size(); ++Index)
+            {
+                Huds[Index] = { this, Index };
+                Reapers[Index] = { this, Index };
+                Spawners[Index] = { this, Index };
+
+                FEntity& Entity = Entities[Index];
+                Entity.OnHealthChanged.AddRaw(&Huds[Index], &FHud::Update);
+                Entity.bHudBound = true;
+                Entity.OnHealthChanged.AddRaw(&Reapers[Index], &FReaper::Update);
+
+                FScenarioCounters* Stats = &Counters;
+                Entity.OnHealthChanged.AddLambda([Stats](int, int, int Delta) { ++Stats->StatsCalls; Stats->Checksum += Delta; });
+
+                if (Index % Config.HistoryEvery == 0)
+                {
+                    std::array<int, 16> Weights;
+                    for (size_t Weight = 0; Weight < Weights.size(); ++Weight) Weights[Weight] = static_cast<int>(Weight + Index);
+                    Entity.OnHealthChanged.AddLambda([Stats, Weights](int, int Health, int) { Stats->Checksum += Weights[static_cast<size_t>(Health) % Weights.size()]; });
+                }
+
+                BindWatcher(Index);
+                Entity.OnHealthChanged.AddRaw(&Spawners[Index], &FPopupSpawner::Update);
+            }
+        }
+
+        // Popups still bound reach into the pool, so the delegates go first.
+        ~TEntityWorld() { Entities.clear(); }
+
+        void RunFrame()
+        {
+            std::uniform_int_distribution<uint32_t> PickEntity(0, static_cast<uint32_t>(Entities.size() - 1));
+            std::uniform_int_distribution<int> PickDelta(-30, 20);
+
+            for (size_t Hit = 0; Hit < Config.HitsPerFrame; ++Hit)
+            {
+                const uint32_t Index = PickEntity(Random);
+                // Heals are rarer than hits: a positive roll heals only every other time.
+                int Delta = PickDelta(Random);
+                if (Delta >= 0 && (Hit & 1)) Delta = -Delta - 1;
+
+                FEntity& Entity = Entities[Index];
+                if (Entity.bDead) continue;
+
+                Entity.Health = std::clamp(Entity.Health + Delta, 0, MaxHealth);
+
+                ++Counters.Broadcasts;
+                ++BroadcastSerial;
+                Entity.OnHealthChanged.Broadcast(MaxHealth, Entity.Health, Delta);
+            }
+
+            for (const uint32_t Index : DeadEntities) Respawn(Index);
+            DeadEntities.clear();
+        }
+
+        // Every broadcast reaches the stats listener once, and the HUD and watcher unless the reaper got to them first
+        // in the broadcast that killed their entity. Popups are either fired or still bound. Anything else is a lost
+        // or extra call.
+        uint64_t CountLostCalls() const
+        {
+            uint64_t Lost = 0;
+            if (Counters.HudCalls + Counters.HudsSkipped != Counters.Broadcasts) ++Lost;
+            if (Counters.StatsCalls != Counters.Broadcasts) ++Lost;
+            if (Counters.WatcherCalls + Counters.Deaths != Counters.Broadcasts) ++Lost;
+            if (Counters.PopupsFired + NumActivePopups != Counters.PopupsSpawned) ++Lost;
+            return Lost;
+        }
+
+        const FScenarioCounters& GetCounters() const { return Counters; }
+
+    private:
+        void BindWatcher(uint32_t Index)
+        {
+            Watchers[Index] = std::make_shared<FWatcher>(this, Index);
+            Entities[Index].OnHealthChanged.AddWeak(std::weak_ptr<FWatcher>(Watchers[Index]), &FWatcher::Update);
+        }
+
+        void Respawn(uint32_t Index)
+        {
+            FEntity& Entity = Entities[Index];
+            Entity.Health = MaxHealth;
+            Entity.bDead = false;
+
+            Entity.OnHealthChanged.AddRaw(&Huds[Index], &FHud::Update);
+            Entity.bHudBound = true;
+            BindWatcher(Index);
+        }
+
+        void SpawnPopup(uint32_t InEntity)
+        {
+            uint32_t Slot = FreePopup;
+            if (Slot != UINT32_MAX)
+            {
+                FreePopup = Popups[Slot].NextFree;
+            }
+            else
+            {
+                Slot = static_cast<uint32_t>(Popups.size());
+                Popups.emplace_back();
+            }
+
+            FPopup& Popup = Popups[Slot];
+            Popup.SpawnedInBroadcast = BroadcastSerial;
+            Popup.Entity = InEntity;
+            Popup.bActive = true;
+            ++NumActivePopups;
+            ++Counters.PopupsSpawned;
+
+            Popup.Handle = Entities[InEntity].OnHealthChanged.AddLambda([this, Slot](int, int, int Delta) { FirePopup(Slot, Delta); });
+        }
+
+        void FirePopup(uint32_t InSlot, int InDelta)
+        {
+            FPopup& Popup = Popups[InSlot];
+            if (!Popup.bActive || Popup.SpawnedInBroadcast == BroadcastSerial)
+            {
+                ++Counters.Violations;
+                return;
+            }
+
+            ++Counters.PopupsFired;
+            Counters.Checksum += InDelta;
+
+            Popup.bActive = false;
+            --NumActivePopups;
+            Entities[Popup.Entity].OnHealthChanged.Remove(Popup.Handle);
+
+            Popup.NextFree = FreePopup;
+            FreePopup = InSlot;
+        }
+
+        FScenarioConfig Config;
+        std::mt19937 Random;
+        FScenarioCounters Counters;
+
+        uint64_t BroadcastSerial = 0;
+        uint64_t SpawnerCalls = 0;
+
+        std::vector<FPopup> Popups;
+        uint32_t FreePopup = UINT32_MAX;
+        uint64_t NumActivePopups = 0;
+
+        std::vector<uint32_t> DeadEntities;
+
+        std::vector<FEntity> Entities;
+        std::vector<FHud> Huds;
+        std::vector<FReaper> Reapers;
+        std::vector<FPopupSpawner> Spawners;
+
+        // Declared before the watchers, which clear their flag when destroyed.
+        std::vector<bool> WatcherAlive;
+        std::vector<std::shared_ptr<FWatcher>> Watchers;
+    };
+
+    // ======================= Report =======================
+
+    double GetPercentile(const std::vector<double>& InSorted, double InFraction)
+    {
+        if (InSorted.empty()) return 0.0;
+
+        const size_t Index = std::min(InSorted.size() - 1, static_cast<size_t>(InFraction * static_cast<double>(InSorted.size())));
+        return InSorted[Index];
+    }
+
+    // Returns false if the variant broke a guarantee.
+    template <typename DelegateType>
+    bool RunScenario(const char* InName, const FScenarioConfig& InConfig)
+    {
+        const uint64_t SetupAllocationsBefore = Benchmarks::GetNumAllocations();
+        TEntityWorld<DelegateType> World(InConfig);
+        const uint64_t SetupAllocations = Benchmarks::GetNumAllocations() - SetupAllocationsBefore;
+
+        for (size_t Frame = 0; Frame < InConfig.NumWarmupFrames; ++Frame) World.RunFrame();
+
+        std::vector<double> FrameMilliseconds;
+        std::vector<double> FrameAllocations;
+        FrameMilliseconds.reserve(InConfig.NumFrames);
+        FrameAllocations.reserve(InConfig.NumFrames);
+
+        for (size_t Frame = 0; Frame < InConfig.NumFrames; ++Frame)
+        {
+            const uint64_t AllocationsBefore = Benchmarks::GetNumAllocations();
+            const auto Start = std::chrono::steady_clock::now();
+
+            World.RunFrame();
+
+            const auto End = std::chrono::steady_clock::now();
+            FrameAllocations.push_back(static_cast<double>(Benchmarks::GetNumAllocations() - AllocationsBefore));
+            FrameMilliseconds.push_back(std::chrono::duration<double, std::milli>(End - Start).count());
+        }
+
+        std::sort(FrameMilliseconds.begin(), FrameMilliseconds.end());
+        std::sort(FrameAllocations.begin(), FrameAllocations.end());
+
+        double TotalAllocations = 0.0;
+        for (const double Allocations : FrameAllocations) TotalAllocations += Allocations;
+
+        const FScenarioCounters& Counters = World.GetCounters();
+        const uint64_t LostCalls = World.CountLostCalls();
+
+        std::printf("%s\n", InName);
+        std::printf("    frame ms      p50 %8.3f  p90 %8.3f  p99 %8.3f  max %8.3f\n",
+            GetPercentile(FrameMilliseconds, 0.5), GetPercentile(FrameMilliseconds, 0.9), GetPercentile(FrameMilliseconds, 0.99), FrameMilliseconds.back());
+        std::printf("    allocs/frame  mean %10.1f  p99 %10.0f  max %10.0f  (setup %llu)\n",
+            TotalAllocations / static_cast<double>(FrameAllocations.size()), GetPercentile(FrameAllocations, 0.99), FrameAllocations.back(),
+            static_cast<unsigned long long>(SetupAllocations));
+        std::printf("    broadcasts %llu  deaths %llu  popups %llu/%llu fired  violations %llu  lost-call checks failed %llu  checksum %lld\n",
+            static_cast<unsigned long long>(Counters.Broadcasts), static_cast<unsigned long long>(Counters.Deaths),
+            static_cast<unsigned long long>(Counters.PopupsFired), static_cast<unsigned long long>(Counters.PopupsSpawned),
+            static_cast<unsigned long long>(Counters.Violations), static_cast<unsigned long long>(LostCalls),
+            static_cast<long long>(Counters.Checksum));
+
+        return Counters.Violations == 0 && LostCalls == 0;
+    }
+}
+
+// Usage: DelegateScenarios [filter] [frames]. Only variants whose name contains the filter are run. Exits with 1 if
+// any variant broke a guarantee.
+int main(int argc, char* argv[])
+{
+    const std::string Filter = argc > 1 ? argv[1] : "";
+
+    FScenarioConfig Config;
+    if (argc > 2) Config.NumFrames = std::max<size_t>(1, static_cast<size_t>(std::strtoull(argv[2], nullptr, 10)));
+
+    std::printf("%zu entities, %zu hits per frame, %zu frames (+%zu warm-up)\n\n", Config.NumEntities, Config.HitsPerFrame, Config.NumFrames, Config.NumWarmupFrames);
+
+    bool bPassed = true;
+    const auto Run = [&]<typename DelegateType>(const char* InName)
+    {
+        if (Filter.empty() || std::string(InName).find(Filter) != std::string::npos) bPassed &= RunScenario<DelegateType>(InName, Config);
+    };
+
+    Run.operator()<Delegates::TMulticastDelegate<FSignal>>("Entities/TMulticastDelegate");
+    Run.operator()<Delegates::TThreadSafeMulticastDelegate<FSignal>>("Entities/TThreadSafeMulticastDelegate");
+    Run.operator()<FSnapshotMulticastDelegate>("Entities/SnapshotBaseline");
+
+    return bPassed ? 0 : 1;
+}
@@ -0,0 +1,184 @@
+#include "DelegateAllocators.h"
+
+#include <algorithm>
+#include <assert.h>
+
+namespace Delegates
+{
+    // ======================= FDelegatePool =======================
+
+    FDelegatePool::FDelegatePool()
+    {
+        for (std::size_t Index = 0; Index < FDelegatePoolStats::NumSizeClasses; ++Index)
+        {
+            Stats.SizeClasses[Index].BlockSize = MinBlockSize << Index;
+        }
+    }
+
+    FDelegatePool::~FDelegatePool()
+    {
+        for (void* Chunk : Chunks) ::operator delete(Chunk);
+    }
+
+    std::size_t FDelegatePool::GetSizeClass(std::size_t InSize)
+    {
+        std::size_t SizeClass = 0;
+        while ((MinBlockSize << SizeClass) < InSize) ++SizeClass;
+        return SizeClass;
+    }
+
+    void* FDelegatePool::Allocate(std::size_t InSize, std::size_t InAlignment)
+    {
+        if (!IsPooled(InSize, InAlignment))
+        {
+            {
+                std::lock_guard<std::mutex> Lock(Mutex);
+                ++Stats.NumFallbackAllocations;
+            }
+            return ::operator new(InSize, std::align_val_t(InAlignment));
+        }
+
+        const std::size_t SizeClass = GetSizeClass(InSize);
+
+        std::lock_guard<std::mutex> Lock(Mutex);
+
+        if (!FreeLists[SizeClass]) AllocateChunk(SizeClass, BlocksPerChunk);
+
+        FFreeBlock* Block = FreeLists[SizeClass];
+        FreeLists[SizeClass] = Block->Next;
+
+        FDelegatePoolStats::FSizeClass& ClassStats = Stats.SizeClasses[SizeClass];
+        --ClassStats.NumFree;
+        ClassStats.PeakLive = std::max(ClassStats.PeakLive, ++ClassStats.NumLive);
+        ++Stats.NumAllocations;
+
+        return Block;
+    }
+
+    void FDelegatePool::Free(void* InPtr, std::size_t InSize, std::size_t InAlignment) noexcept
+    {
+        if (!InPtr) return;
+
+        if (!IsPooled(InSize, InAlignment))
+        {
+            ::operator delete(InPtr, InSize, std::align_val_t(InAlignment));
+            return;
+        }
+
+        const std::size_t SizeClass = GetSizeClass(InSize);
+
+        std::lock_guard<std::mutex> Lock(Mutex);
+
+        FFreeBlock* Block = static_cast<FFreeBlock*>(InPtr);
+        Block->Next = FreeLists[SizeClass];
+        FreeLists[SizeClass] = Block;
+
+        FDelegatePoolStats::FSizeClass& ClassStats = Stats.SizeClasses[SizeClass];
+        assert(ClassStats.NumLive > 0);
+        --ClassStats.NumLive;
+        ++ClassStats.NumFree;
+    }
+
+    void FDelegatePool::Reserve(std::size_t InSize, std::size_t InNumBlocks)
+    {
+        if (!IsPooled(InSize, alignof(std::max_align_t))) return;
+
+        const std::size_t SizeClass = GetSizeClass(InSize);
+
+        std::lock_guard<std::mutex> Lock(Mutex);
+
+        const uint64_t NumFree = Stats.SizeClasses[SizeClass].NumFree;
+        if (NumFree < InNumBlocks) AllocateChunk(SizeClass, static_cast<std::size_t>(InNumBlocks - NumFree));
+    }
+
+    FDelegatePoolStats FDelegatePool::GetStats() const
+    {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        return Stats;
+    }
+
+    // Called with Mutex held. Carves a new chunk into blocks and pushes them on the size class's freelist.
+    void FDelegatePool::AllocateChunk(std::size_t InSizeClass, std::size_t InNumBlocks)
+    {
+        const std::size_t BlockSize = MinBlockSize << InSizeClass;
+        unsigned char* Chunk = static_cast<unsigned char*>(::operator new(BlockSize * InNumBlocks));
+        Chunks.push_back(Chunk);
+
+        for (std::size_t Index = InNumBlocks; Index-- > 0;)
+        {
+            FFreeBlock* Block = reinterpret_cast<FFreeBlock*>(Chunk + Index * BlockSize);
+            Block->Next = FreeLists[InSizeClass];
+            FreeLists[InSizeClass] = Block;
+        }
+
+        Stats.SizeClasses[InSizeClass].NumFree += InNumBlocks;
+        ++Stats.NumChunks;
+        Stats.ReservedBytes += BlockSize * InNumBlocks;
+    }
+
+    // ======================= FDelegateFrameArena =======================
+
+    FDelegateFrameArena::FDelegateFrameArena(std::size_t InCapacity)
+    {
+        Stats.CapacityBytes = InCapacity;
+        if (InCapacity > 0) Block = static_cast<unsigned char*>(::operator new(InCapacity));
+    }
+
+    FDelegateFrameArena::~FDelegateFrameArena()
+    {
+        ::operator delete(Block);
+        for (const FOverflowBlock& Overflow : OverflowBlocks) FDelegateHeapAllocator::Free(Overflow.Ptr, Overflow.Size, Overflow.Alignment);
+    }
+
+    void* FDelegateFrameArena::Allocate(std::size_t InSize, std::size_t InAlignment)
+    {
+        ++Stats.NumLive;
+
+        const uintptr_t Base = reinterpret_cast<uintptr_t>(Block);
+        const std::size_t Aligned = static_cast<std::size_t>(((Base + Offset + InAlignment - 1) & ~(uintptr_t(InAlignment) - 1)) - Base);
+        if (Block && Aligned + InSize <= Stats.CapacityBytes)
+        {
+            Offset = Aligned + InSize;
+            Stats.UsedBytes = Offset;
+            Stats.PeakUsedBytes = std::max(Stats.PeakUsedBytes, Stats.UsedBytes);
+            return Block + Aligned;
+        }
+
+        // Out of space this frame: serve it from the heap and remember the size, so Reset can grow the arena.
+        void* Overflow = FDelegateHeapAllocator::Allocate(InSize, InAlignment);
+        OverflowBlocks.push_back({ Overflow, InSize, InAlignment });
+        OverflowBytes += InSize + InAlignment;
+
+        ++Stats.NumOverflowBlocks;
+        Stats.PeakUsedBytes = std::max(Stats.PeakUsedBytes, Stats.CapacityBytes + OverflowBytes);
+        return Overflow;
+    }
+
+    void FDelegateFrameArena::Free(void* InPtr, std::size_t, std::size_t) noexcept
+    {
+        if (!InPtr) return;
+
+        assert(Stats.NumLive > 0);
+        --Stats.NumLive;
+    }
+
+    void FDelegateFrameArena::Reset()
+    {
+        assert(Stats.NumLive == 0 && "Frame arena reset while transient bindings still use it");
+
+        if (!OverflowBlocks.empty())
+        {
+            for (const FOverflowBlock& Overflow : OverflowBlocks) FDelegateHeapAllocator::Free(Overflow.Ptr, Overflow.Size, Overflow.Alignment);
+            OverflowBlocks.clear();
+            OverflowBytes = 0;
+
+            ::operator delete(Block);
+            Stats.CapacityBytes = Stats.PeakUsedBytes;
+            Block = static_cast<unsigned char*>(::operator new(Stats.CapacityBytes));
+        }
+
+        Offset = 0;
+        Stats.UsedBytes = 0;
+        Stats.NumOverflowBlocks = 0;
+    }
+}
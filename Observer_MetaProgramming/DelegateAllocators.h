@@ -0,0 +1,234 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace Delegates
+{
+    // Allocator policies decide where a delegate puts what does not fit inline: heap-stored instances (large lambda
+    // captures) and the listener arrays of a multicast delegate. A policy is a stateless type with
+    //
+    //   static void* Allocate(std::size_t InSize, std::size_t InAlignment);
+    //   static void Free(void* InPtr, std::size_t InSize, std::size_t InAlignment) noexcept;
+    //
+    // A policy whose memory only lives for a frame also declares `static constexpr bool bFrameScoped = true;`. It then
+    // only stores instances; listener arrays outlive frames, so they stay on the heap.
+
+    // ======================= Heap (default) =======================
+
+    struct FDelegateHeapAllocator
+    {
+        static void* Allocate(std::size_t InSize, std::size_t InAlignment)
+        {
+            if (InAlignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) return ::operator new(InSize, std::align_val_t(InAlignment));
+            return ::operator new(InSize);
+        }
+
+        static void Free(void* InPtr, std::size_t InSize, std::size_t InAlignment) noexcept
+        {
+            if (InAlignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) ::operator delete(InPtr, InSize, std::align_val_t(InAlignment));
+            else ::operator delete(InPtr, InSize);
+        }
+    };
+
+    // ======================= Freelist Pool =======================
+
+    struct FDelegatePoolStats
+    {
+        struct FSizeClass
+        {
+            std::size_t BlockSize = 0;
+            uint64_t NumLive = 0;
+            uint64_t PeakLive = 0;
+            uint64_t NumFree = 0;
+        };
+
+        static constexpr std::size_t NumSizeClasses = 6;
+
+        FSizeClass SizeClasses[NumSizeClasses];
+
+        uint64_t NumAllocations = 0;
+        // Requests larger or more aligned than the biggest size class; served by the heap.
+        uint64_t NumFallbackAllocations = 0;
+        uint64_t NumChunks = 0;
+        std::size_t ReservedBytes = 0;
+    };
+
+    // Size-classed freelists (16 to 512 bytes). Freed blocks go back to their list and are reused by the next
+    // allocation of that class; memory is only returned to the system when the pool is destroyed. Thread-safe.
+    class FDelegatePool
+    {
+    public:
+        static constexpr std::size_t MinBlockSize = 16;
+        static constexpr std::size_t MaxBlockSize = MinBlockSize << (FDelegatePoolStats::NumSizeClasses - 1);
+        static constexpr std::size_t BlocksPerChunk = 64;
+
+        FDelegatePool();
+        ~FDelegatePool();
+
+        FDelegatePool(const FDelegatePool&) = delete;
+        FDelegatePool& operator=(const FDelegatePool&) = delete;
+
+        void* Allocate(std::size_t InSize, std::size_t InAlignment);
+        void Free(void* InPtr, std::size_t InSize, std::size_t InAlignment) noexcept;
+
+        // Makes sure InNumBlocks blocks of the size class serving InSize are free, so they bind without allocating.
+        void Reserve(std::size_t InSize, std::size_t InNumBlocks);
+
+        FDelegatePoolStats GetStats() const;
+
+    private:
+        struct FFreeBlock
+        {
+            FFreeBlock* Next;
+        };
+
+        static bool IsPooled(std::size_t InSize, std::size_t InAlignment) { return InSize <= MaxBlockSize && InAlignment <= alignof(std::max_align_t); }
+        static std::size_t GetSizeClass(std::size_t InSize);
+
+        void AllocateChunk(std::size_t InSizeClass, std::size_t InNumBlocks);
+
+    private:
+        mutable std::mutex Mutex;
+
+        FFreeBlock* FreeLists[FDelegatePoolStats::NumSizeClasses] = {};
+        std::vector<void*> Chunks;
+        FDelegatePoolStats Stats;
+    };
+
+    // One pool per Tag; tagging with the delegate signature gives every signature its own freelists.
+    //
+    //   using FOnHit = TMulticastDelegate<void(const FHitResult&), TDelegatePoolAllocator<void(const FHitResult&)>>;
+    template <typename Tag>
+    struct TDelegatePoolAllocator
+    {
+        // Never destroyed, so delegates living in other static objects can still free into it at exit.
+        static FDelegatePool& GetPool()
+        {
+            static FDelegatePool* Pool = new FDelegatePool();
+            return *Pool;
+        }
+
+        static void* Allocate(std::size_t InSize, std::size_t InAlignment) { return GetPool().Allocate(InSize, InAlignment); }
+        static void Free(void* InPtr, std::size_t InSize, std::size_t InAlignment) noexcept { GetPool().Free(InPtr, InSize, InAlignment); }
+    };
+
+    // ======================= Frame Arena =======================
+
+    struct FDelegateArenaStats
+    {
+        std::size_t CapacityBytes = 0;
+        std::size_t UsedBytes = 0;
+        // Highest UsedBytes since the arena was created; Reset grows the arena to it.
+        std::size_t PeakUsedBytes = 0;
+        uint64_t NumLive = 0;
+        // Allocations this frame that did not fit and went to the heap.
+        uint64_t NumOverflowBlocks = 0;
+    };
+
+    // Bump allocator for transient bindings (one-shot callbacks bound and unbound within a frame). Free only counts;
+    // memory is reclaimed all at once by Reset, which expects every allocation to be freed by then.
+    // Not thread-safe: use it from the thread that owns the frame.
+    class FDelegateFrameArena
+    {
+    public:
+        static constexpr std::size_t DefaultCapacity = 64 * 1024;
+
+        explicit FDelegateFrameArena(std::size_t InCapacity = DefaultCapacity);
+        ~FDelegateFrameArena();
+
+        FDelegateFrameArena(const FDelegateFrameArena&) = delete;
+        FDelegateFrameArena& operator=(const FDelegateFrameArena&) = delete;
+
+        void* Allocate(std::size_t InSize, std::size_t InAlignment);
+        void Free(void* InPtr, std::size_t InSize, std::size_t InAlignment) noexcept;
+
+        // Rewinds the arena. Overflow blocks allocated this frame are released and folded into a single larger block.
+        void Reset();
+
+        __forceinline const FDelegateArenaStats& GetStats() const { return Stats; }
+
+    private:
+        struct FOverflowBlock
+        {
+            void* Ptr;
+            std::size_t Size;
+            std::size_t Alignment;
+        };
+
+        unsigned char* Block = nullptr;
+        std::size_t Offset = 0;
+
+        std::vector<FOverflowBlock> OverflowBlocks;
+        std::size_t OverflowBytes = 0;
+
+        FDelegateArenaStats Stats;
+    };
+
+    // One arena per Tag. Call ResetFrame once per frame, after the transient bindings are gone. As a multicast
+    // delegate's policy it holds only the listener instances that don't fit inline, so the delegate itself may outlive
+    // the frame as long as those listeners are removed before ResetFrame.
+    template <typename Tag = void>
+    struct TDelegateFrameArenaAllocator
+    {
+        static constexpr bool bFrameScoped = true;
+
+        static FDelegateFrameArena& GetArena()
+        {
+            static FDelegateFrameArena* Arena = new FDelegateFrameArena();
+            return *Arena;
+        }
+
+        static void ResetFrame() { GetArena().Reset(); }
+
+        static void* Allocate(std::size_t InSize, std::size_t InAlignment) { return GetArena().Allocate(InSize, InAlignment); }
+        static void Free(void* InPtr, std::size_t InSize, std::size_t InAlignment) noexcept { GetArena().Free(InPtr, InSize, InAlignment); }
+    };
+
+    // ======================= Container Adapter =======================
+
+    // std allocator over a delegate allocator policy, for the vectors inside multicast delegates.
+    template <typename T, typename Allocator>
+    struct TDelegateStdAllocator
+    {
+        using value_type = T;
+
+        TDelegateStdAllocator() = default;
+        template <typename U>
+        TDelegateStdAllocator(const TDelegateStdAllocator<U, Allocator>&) noexcept {}
+
+        T* allocate(std::size_t InCount) { return static_cast<T*>(Allocator::Allocate(InCount * sizeof(T), alignof(T))); }
+        void deallocate(T* InPtr, std::size_t InCount) noexcept { Allocator::Free(InPtr, InCount * sizeof(T), alignof(T)); }
+
+        template <typename U>
+        bool operator==(const TDelegateStdAllocator<U, Allocator>&) const noexcept { return true; }
+    };
+
+    template <typename T, typename Allocator>
+    struct TDelegateContainerAllocatorType
+    {
+        using Type = TDelegateStdAllocator<T, Allocator>;
+    };
+
+    template <typename T>
+    struct TDelegateContainerAllocatorType<T, FDelegateHeapAllocator>
+    {
+        using Type = std::allocator<T>;
+    };
+
+    template <typename T, typename Allocator>
+        requires (Allocator::bFrameScoped)
+    struct TDelegateContainerAllocatorType<T, Allocator>
+    {
+        using Type = std::allocator<T>;
+    };
+
+    template <typename T, typename Allocator>
+    using TDelegateContainerAllocator = typename TDelegateContainerAllocatorType<T, Allocator>::Type;
+
+    template <typename T, typename Allocator>
+    using TDelegateVector = std::vector<T, TDelegateContainerAllocator<T, Allocator>>;
+}
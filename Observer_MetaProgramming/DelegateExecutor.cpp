@@ -0,0 +1,131 @@
+#include "DelegateExecutor.h"
+
+#include <algorithm>
+
+namespace Delegates
+{
+    namespace
+    {
+        // Set on worker threads, so a ParallelFor issued from inside a task starts with the worker's own queue.
+        thread_local const FWorkStealingExecutor* GCurrentExecutor = nullptr;
+        thread_local uint32_t GCurrentWorkerIndex = 0;
+    }
+
+    uint32_t FWorkStealingExecutor::GetDefaultNumWorkers()
+    {
+        const uint32_t NumThreads = std::thread::hardware_concurrency();
+        return NumThreads > 1 ? NumThreads - 1 : 0;
+    }
+
+    FWorkStealingExecutor::FWorkStealingExecutor(uint32_t InNumWorkers)
+    {
+        // The caller still needs a queue to push to when there are no workers.
+        const uint32_t NumQueues = std::max<uint32_t>(InNumWorkers, 1);
+        for (uint32_t Index = 0; Index < NumQueues; ++Index) Queues.push_back(std::make_unique<FWorkerQueue>());
+
+        Workers.reserve(InNumWorkers);
+        for (uint32_t Index = 0; Index < InNumWorkers; ++Index) Workers.emplace_back(&FWorkStealingExecutor::WorkerMain, this, Index);
+    }
+
+    FWorkStealingExecutor::~FWorkStealingExecutor()
+    {
+        {
+            std::lock_guard<std::mutex> Lock(WakeMutex);
+            bStopping = true;
+        }
+        WakeCondition.notify_all();
+
+        for (std::thread& Worker : Workers) Worker.join();
+    }
+
+    void FWorkStealingExecutor::ParallelFor(uint32_t InNumTasks, FTaskFunc InTask, void* InContext)
+    {
+        if (InNumTasks == 0) return;
+
+        FJob Job{ InTask, InContext, { InNumTasks } };
+
+        // Counted before they are pushed, so a pop never sees more items than NumQueued.
+        {
+            std::lock_guard<std::mutex> Lock(WakeMutex);
+            NumQueued.fetch_add(InNumTasks, std::memory_order_release);
+        }
+
+        // Spread the tasks round-robin, so every worker starts on its own queue and only steals near the end.
+        const uint32_t NumQueues = static_cast<uint32_t>(Queues.size());
+        const uint32_t FirstQueue = NextQueue.fetch_add(1, std::memory_order_relaxed);
+        for (uint32_t TaskIndex = 0; TaskIndex < InNumTasks; ++TaskIndex)
+        {
+            FWorkerQueue& Queue = *Queues[(FirstQueue + TaskIndex) % NumQueues];
+            std::lock_guard<std::mutex> Lock(Queue.Mutex);
+            Queue.Items.push_back({ &Job, TaskIndex });
+        }
+        WakeCondition.notify_all();
+
+        // Help until every task of this job is done; items taken here may belong to other jobs.
+        const uint32_t OwnQueue = GCurrentExecutor == this ? GCurrentWorkerIndex : FirstQueue % NumQueues;
+        while (Job.NumRemaining.load(std::memory_order_acquire) > 0)
+        {
+            FWorkItem Item;
+            if (TryPop(OwnQueue, Item)) Execute(Item);
+            else std::this_thread::yield();
+        }
+    }
+
+    void FWorkStealingExecutor::WorkerMain(uint32_t InWorkerIndex)
+    {
+        GCurrentExecutor = this;
+        GCurrentWorkerIndex = InWorkerIndex;
+
+        for (;;)
+        {
+            FWorkItem Item;
+            if (TryPop(InWorkerIndex, Item))
+            {
+                Execute(Item);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> Lock(WakeMutex);
+            WakeCondition.wait(Lock, [this] { return bStopping || NumQueued.load(std::memory_order_acquire) > 0; });
+            if (bStopping) return;
+        }
+    }
+
+    bool FWorkStealingExecutor::TryPop(uint32_t InWorkerIndex, FWorkItem& OutItem)
+    {
+        if (NumQueued.load(std::memory_order_acquire) == 0) return false;
+
+        const uint32_t NumQueues = static_cast<uint32_t>(Queues.size());
+        for (uint32_t Offset = 0; Offset < NumQueues; ++Offset)
+        {
+            FWorkerQueue& Queue = *Queues[(InWorkerIndex + Offset) % NumQueues];
+            std::lock_guard<std::mutex> Lock(Queue.Mutex);
+            if (Queue.Items.empty()) continue;
+
+            if (Offset == 0)
+            {
+                OutItem = Queue.Items.back();
+                Queue.Items.pop_back();
+            }
+            else
+            {
+                OutItem = Queue.Items.front();
+                Queue.Items.pop_front();
+            }
+
+            NumQueued.fetch_sub(1, std::memory_order_acq_rel);
+            return true;
+        }
+
+        return false;
+    }
+
+    void FWorkStealingExecutor::Execute(const FWorkItem& InItem)
+    {
+        FJob& Job = *InItem.Job;
+        Job.Task(Job.Context, InItem.TaskIndex);
+
+        // The job lives on its caller's stack, so it must not be touched after the last decrement.
+        Job.NumRemaining.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Delegates
+{
+    // ======================= Work-Stealing Executor =======================
+
+    // Fixed pool of worker threads for TMulticastDelegate::ParallelBroadcast. Each worker owns a task queue: it pops
+    // from the back of its own and, once that is empty, steals from the front of the others. The thread calling
+    // ParallelFor works through the queues too, so nested ParallelFor calls cannot deadlock and a pool with no
+    // workers degrades to running everything on the caller.
+    //
+    // Any type with the same GetNumWorkers/ParallelFor members can be passed to ParallelBroadcast instead.
+    class FWorkStealingExecutor
+    {
+    public:
+        using FTaskFunc = void(*)(void* InContext, uint32_t InTaskIndex);
+
+        // One worker per hardware thread, minus one for the caller.
+        static uint32_t GetDefaultNumWorkers();
+
+        explicit FWorkStealingExecutor(uint32_t InNumWorkers = GetDefaultNumWorkers());
+        ~FWorkStealingExecutor();
+
+        FWorkStealingExecutor(const FWorkStealingExecutor&) = delete;
+        FWorkStealingExecutor& operator=(const FWorkStealingExecutor&) = delete;
+
+        __forceinline uint32_t GetNumWorkers() const { return static_cast<uint32_t>(Workers.size()); }
+
+        // Calls InTask(InContext, Index) for every Index in [0, InNumTasks) and returns once all calls have finished.
+        // Thread-safe; tasks of concurrent calls share the workers.
+        void ParallelFor(uint32_t InNumTasks, FTaskFunc InTask, void* InContext);
+
+    private:
+        struct FJob
+        {
+            FTaskFunc Task;
+            void* Context;
+            std::atomic<uint32_t> NumRemaining;
+        };
+
+        struct FWorkItem
+        {
+            FJob* Job;
+            uint32_t TaskIndex;
+        };
+
+        struct alignas(64) FWorkerQueue
+        {
+            std::mutex Mutex;
+            std::deque<FWorkItem> Items;
+        };
+
+        void WorkerMain(uint32_t InWorkerIndex);
+
+        // Own queue first (newest item), then the others (oldest item) starting after it.
+        bool TryPop(uint32_t InWorkerIndex, FWorkItem& OutItem);
+
+        static void Execute(const FWorkItem& InItem);
+
+    private:
+        std::vector<std::unique_ptr<FWorkerQueue>> Queues;
+        std::vector<std::thread> Workers;
+
+        // Items queued and not yet taken; workers sleep on WakeCondition while it is zero.
+        std::atomic<uint64_t> NumQueued{ 0 };
+        std::atomic<uint32_t> NextQueue{ 0 };
+
+        std::mutex WakeMutex;
+        std::condition_variable WakeCondition;
+        bool bStopping = false;
+    };
+}
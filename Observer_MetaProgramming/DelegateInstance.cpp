@@ -3,11 +3,31 @@
 
 namespace Delegates
 {
+    namespace
+    {
+        // Each thread reserves IDs in blocks, so binding on many threads at once does not contend on one cache line.
+        constexpr uint64_t DelegateIDBlockSize = 4096;
+
+        struct FThreadIDBlock
+        {
+            uint64_t NextID = 0;
+            uint64_t EndID = 0;
+        };
+
+        thread_local FThreadIDBlock GThreadIDBlock;
+    }
+
     std::atomic<uint64_t> GDelegateNextID(1);
 
     uint64_t FDelegateHandle::GenerateNewID()
     {
-        return GDelegateNextID.fetch_add(1, std::memory_order_relaxed);
+        FThreadIDBlock& Block = GThreadIDBlock;
+        if (Block.NextID == Block.EndID)
+        {
+            Block.NextID = GDelegateNextID.fetch_add(DelegateIDBlockSize, std::memory_order_relaxed);
+            Block.EndID = Block.NextID + DelegateIDBlockSize;
+        }
+        return Block.NextID++;
     }
 }
 
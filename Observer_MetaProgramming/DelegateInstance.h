@@ -1,12 +1,44 @@
 ﻿#pragma once
+#include <algorithm>
 #include <assert.h>
+#include <bit>
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
 #include <cstdint>
-#include <functional>
+#include <cstring>
 #include <memory>
+#include <functional>
+#include <new>
+#include <optional>
+#include <span>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "DelegateAllocators.h"
+#include "DelegateStats.h"
+
+// BroadcastKeyed compares four filter keys per instruction where SSE2 is available (every x64 target).
+#ifndef DELEGATES_WITH_SSE2
+#if defined(_M_X64) || defined(__SSE2__)
+#define DELEGATES_WITH_SSE2 1
+#else
+#define DELEGATES_WITH_SSE2 0
+#endif
+#endif
+
+#if DELEGATES_WITH_SSE2
+#include <emmintrin.h>
+#endif
 
 namespace Delegates
 {
     // ======================= Handle =======================
+
+    // DelegateID is unique per binding and is what identifies the handle. The slot index only tells a multicast
+    // delegate where to look; since IDs are never reused, the ID also serves as the slot's generation.
+    // IDs are unique but not ordered: each thread hands them out from its own reserved block.
     class FDelegateHandle
     {
     public:
@@ -15,19 +47,24 @@ namespace Delegates
             GenerateNewHandle
         };
 
+        static constexpr uint32_t InvalidSlot = UINT32_MAX;
+
     public:
         FDelegateHandle()
-            : DelegateID(0)
+            : DelegateID(0), Slot(InvalidSlot)
         {
         }
 
         explicit FDelegateHandle(GenerateNewHandleType)
-            : DelegateID(GenerateNewID())
+            : DelegateID(GenerateNewID()), Slot(InvalidSlot)
         {
         }
 
         __forceinline bool IsValid() const { return DelegateID != 0; }
-        __forceinline void Reset() { DelegateID = 0; }
+        __forceinline void Reset() { DelegateID = 0; Slot = InvalidSlot; }
+
+        __forceinline uint32_t GetSlot() const { return Slot; }
+        __forceinline FDelegateHandle WithSlot(uint32_t InSlot) const { FDelegateHandle Result = *this; Result.Slot = InSlot; return Result; }
 
         bool operator==(const FDelegateHandle& Other) const { return DelegateID == Other.DelegateID; }
         bool operator!=(const FDelegateHandle& Other) const { return DelegateID != Other.DelegateID; }
@@ -36,6 +73,7 @@ namespace Delegates
         static uint64_t GenerateNewID();
 
         uint64_t DelegateID;
+        uint32_t Slot;
     };
 
     // ==================== Base Instance ====================
@@ -47,8 +85,6 @@ namespace Delegates
 
         virtual bool IsCompactable() const { return !IsSafeToExecute(); }
         virtual bool IsSafeToExecute() const = 0;
-
-        virtual FDelegateHandle GetHandle() const = 0;
     };
 
     template <typename Signature>
@@ -81,6 +117,31 @@ namespace Delegates
     template <typename Class, typename Signature>
     using TMemFuncPtr = typename TMemFunсPtrType<Class, Signature>::Type;
 
+    // How an argument travels from Broadcast/Execute down to the bound callable. Small trivially copyable values go
+    // by value, anything else by const reference, so a multicast hands every listener the same argument without
+    // copying it per layer. Reference parameters are kept as declared; move-only values go as rvalue references.
+    template <typename T>
+    struct TDelegateParamType
+    {
+        using Type = std::conditional_t<std::is_trivially_copyable_v<T> && sizeof(T) <= 2 * sizeof(void*), T,
+            std::conditional_t<std::is_copy_constructible_v<T>, const T&, T&&>>;
+    };
+
+    template <typename T>
+    struct TDelegateParamType<T&>
+    {
+        using Type = T&;
+    };
+
+    template <typename T>
+    struct TDelegateParamType<T&&>
+    {
+        using Type = T&&;
+    };
+
+    template <typename T>
+    using TDelegateParam = typename TDelegateParamType<T>::Type;
+
     template <typename RetType, typename... ArgsType>
     class TDelegateInstanceBase : public IDelegateInstance
     {
@@ -89,333 +150,2204 @@ namespace Delegates
         virtual ~TDelegateInstanceBase() = default;
 
     public:
-        virtual RetType Execute(ArgsType... Args) = 0;
-        virtual RetType ExecuteIfSafe(ArgsType... Args) = 0;
-    };
+        virtual RetType Execute(TDelegateParam<ArgsType>... Args) = 0;
+        virtual RetType ExecuteIfSafe(TDelegateParam<ArgsType>... Args) = 0;
 
-    // ============ Concrete Instances (Static, Raw, Weak, Lambda) ============
+        // Checks and calls in one step (one weak_ptr lock for weak bindings); the result is dropped.
+        // Returns false if the binding was not safe to execute.
+        virtual bool TryExecute(TDelegateParam<ArgsType>... Args) = 0;
 
-    template <typename RetType, typename... ArgsType>
-    class TStaticDelegateInstance final : public TDelegateInstanceBase<RetType, ArgsType...>
+        // Pinning: PinObject returns a strong reference to the bound object, or null if the binding holds none.
+        // While the caller keeps it alive, ExecutePinned calls the bound method on it without re-checking.
+        virtual std::shared_ptr<const void> PinObject() const { return nullptr; }
+        virtual RetType ExecutePinned([[maybe_unused]] const void* InPinnedObject, TDelegateParam<ArgsType>... Args)
+        {
+            return Execute(std::forward<TDelegateParam<ArgsType>>(Args)...);
+        }
+
+        // Move-constructs this instance into raw storage at InDest and returns the new instance.
+        virtual TDelegateInstanceBase* MoveTo(void* InDest) noexcept = 0;
+    };
+
+    // The calling side every concrete instance shares. DerivedType provides GetTarget(), which resolves what it calls
+    // through and tests false when the binding cannot run (a null pointer, an empty shared_ptr), and Call(Target, Args...).
+    // Each entry point resolves the target once, and `return RetType()` covers void and non-void signatures alike.
+    // Never instantiated on its own, so it needs no vtable of its own.
+    template <typename DerivedType, typename RetType, typename... ArgsType>
+    class __declspec(novtable) TDelegateInstanceImpl : public TDelegateInstanceBase<RetType, ArgsType...>
     {
     public:
-        explicit TStaticDelegateInstance(TFuncPtr<RetType(ArgsType...)> InFn)
-            : Func(InFn), Handle(FDelegateHandle::GenerateNewHandle) {}
+        RetType Execute(TDelegateParam<ArgsType>... Args) override
+        {
+            auto Target = Self().GetTarget();
+            assert(Target);
+            return Self().Call(Target, std::forward<TDelegateParam<ArgsType>>(Args)...);
+        }
 
-        __forceinline bool IsSafeToExecute() const { return Func != nullptr; }
-        __forceinline FDelegateHandle GetHandle() const override { return Handle; }
+        RetType ExecuteIfSafe(TDelegateParam<ArgsType>... Args) override
+        {
+            auto Target = Self().GetTarget();
+            if (!Target) return RetType();
+            return Self().Call(Target, std::forward<TDelegateParam<ArgsType>>(Args)...);
+        }
 
-        RetType Execute(ArgsType... Args) override
+        bool TryExecute(TDelegateParam<ArgsType>... Args) override
         {
-            assert(IsSafeToExecute());
-            if constexpr (std::is_void_v<RetType>) { Func(std::forward<ArgsType>(Args)...); }
-            else { return Func(std::forward<ArgsType>(Args)...); }
+            auto Target = Self().GetTarget();
+            if (!Target) return false;
+
+            Self().Call(Target, std::forward<TDelegateParam<ArgsType>>(Args)...);
+            return true;
         }
 
-        RetType ExecuteIfSafe(ArgsType... Args) override
+        TDelegateInstanceBase<RetType, ArgsType...>* MoveTo(void* InDest) noexcept override
         {
-            if (IDelegateInstance::IsCompactable())
-            {
-                if constexpr (!std::is_void_v<RetType>) return RetType{};
-                else return;
-            }
-            return Func(std::forward<ArgsType>(Args)...);
+            return new (InDest) DerivedType(std::move(Self()));
         }
 
     private:
-        TFuncPtr<RetType(ArgsType...)> Func = nullptr;
-        FDelegateHandle Handle;
+        __forceinline DerivedType& Self() { return static_cast<DerivedType&>(*this); }
     };
 
-    template <typename Class, typename RetType, typename... ArgsType>
-    class TRawDelegateInstance final : public TDelegateInstanceBase<RetType, ArgsType...>
+    // ============ Concrete Instances (Static, Raw, Weak, Lambda) ============
+
+    template <typename RetType, typename... ArgsType>
+    class TStaticDelegateInstance final : public TDelegateInstanceImpl<TStaticDelegateInstance<RetType, ArgsType...>, RetType, ArgsType...>
     {
-        using MethodType = TMemFuncPtr<Class, RetType(ArgsType...)>;
+        using FuncType = TFuncPtr<RetType(ArgsType...)>;
+        friend TDelegateInstanceImpl<TStaticDelegateInstance, RetType, ArgsType...>;
 
     public:
+        explicit TStaticDelegateInstance(FuncType InFn) : Func(InFn) {}
 
-        TRawDelegateInstance(Class* InClassPtr, MethodType InMethod)
-            : ClassPtr(InClassPtr), Method(InMethod), Handle(FDelegateHandle::GenerateNewHandle) {}
+        __forceinline bool IsSafeToExecute() const override { return Func != nullptr; }
 
-        __forceinline bool IsSafeToExecute() const override { return ClassPtr != nullptr && Method != nullptr; }
-        __forceinline FDelegateHandle GetHandle() const override { return Handle; }
+    private:
+        __forceinline FuncType GetTarget() const { return Func; }
 
-        RetType Execute(ArgsType... Args) override
+        static __forceinline RetType Call(FuncType InFunc, TDelegateParam<ArgsType>... Args)
         {
-            assert(IsSafeToExecute());
-            if constexpr (std::is_void_v<RetType>) { (ClassPtr->*Method)(std::forward<ArgsType>(Args)...); }
-            else { return (ClassPtr->*Method)(std::forward<ArgsType>(Args)...); }
+            return InFunc(std::forward<TDelegateParam<ArgsType>>(Args)...);
         }
 
-        RetType ExecuteIfSafe(ArgsType... Args) override
+        FuncType Func = nullptr;
+    };
+
+    template <typename Class, typename RetType, typename... ArgsType>
+    class TRawDelegateInstance final : public TDelegateInstanceImpl<TRawDelegateInstance<Class, RetType, ArgsType...>, RetType, ArgsType...>
+    {
+        using MethodType = TMemFuncPtr<Class, RetType(ArgsType...)>;
+        friend TDelegateInstanceImpl<TRawDelegateInstance, RetType, ArgsType...>;
+
+    public:
+        TRawDelegateInstance(Class* InClassPtr, MethodType InMethod) : ClassPtr(InClassPtr), Method(InMethod) {}
+
+        __forceinline bool IsSafeToExecute() const override { return ClassPtr != nullptr && Method != nullptr; }
+
+    private:
+        __forceinline Class* GetTarget() const { return Method != nullptr ? ClassPtr : nullptr; }
+
+        __forceinline RetType Call(Class* InObject, TDelegateParam<ArgsType>... Args) const
         {
-            if (IDelegateInstance::IsCompactable())
-            {
-                if constexpr (!std::is_void_v<RetType>) return RetType{};
-                else return;
-            }
-            return Execute(std::forward<ArgsType>(Args)...);
+            return (InObject->*Method)(std::forward<TDelegateParam<ArgsType>>(Args)...);
         }
 
-    private:
         Class* ClassPtr = nullptr;
         MethodType Method = nullptr;
-        FDelegateHandle Handle;
     };
 
     template <typename Class, typename RetType, typename... ArgsType>
-    class TWeakDelegateInstance final : public TDelegateInstanceBase<RetType, ArgsType...>
+    class TWeakDelegateInstance final : public TDelegateInstanceImpl<TWeakDelegateInstance<Class, RetType, ArgsType...>, RetType, ArgsType...>
     {
+        friend TDelegateInstanceImpl<TWeakDelegateInstance, RetType, ArgsType...>;
+
     public:
         using MethodType = TMemFuncPtr<Class, RetType(ArgsType...)>;
 
-        TWeakDelegateInstance(std::weak_ptr<Class> InWeak, MethodType InMethod)
-            : Weak(InWeak), Method(InMethod), Handle(FDelegateHandle::GenerateNewHandle) {}
+        TWeakDelegateInstance(std::weak_ptr<Class> InWeak, MethodType InMethod) : Weak(InWeak), Method(InMethod) {}
 
         __forceinline bool IsSafeToExecute() const override { return !Weak.expired() && Method != nullptr; }
-        __forceinline FDelegateHandle GetHandle() const override { return Handle; }
 
-        RetType Execute(ArgsType... Args) override
+        std::shared_ptr<const void> PinObject() const override { return Method != nullptr ? Weak.lock() : nullptr; }
+
+        RetType ExecutePinned(const void* InPinnedObject, TDelegateParam<ArgsType>... Args) override
         {
-            assert(IsSafeToExecute());
-            auto ObjectContext = Weak.lock();
-            if constexpr (std::is_void_v<RetType>) { (ObjectContext.get()->*Method)(std::forward<ArgsType>(Args)...); }
-            else { return (ObjectContext.get()->*Method)(std::forward<ArgsType>(Args)...); }
+            Class* Object = static_cast<Class*>(const_cast<void*>(InPinnedObject));
+            return (Object->*Method)(std::forward<TDelegateParam<ArgsType>>(Args)...);
         }
 
-        RetType ExecuteIfSafe(ArgsType... Args) override
+    private:
+        // Lock once and call through the locked pointer: expired() followed by lock() would touch the control block twice.
+        __forceinline std::shared_ptr<Class> GetTarget() const { return Method != nullptr ? Weak.lock() : nullptr; }
+
+        __forceinline RetType Call(const std::shared_ptr<Class>& InObject, TDelegateParam<ArgsType>... Args) const
         {
-            if (!IsSafeToExecute())
-            {
-                if constexpr (!std::is_void_v<RetType>) return RetType{};
-                else return;
-            }
-            return Execute(std::forward<ArgsType>(Args)...);
+            return (InObject.get()->*Method)(std::forward<TDelegateParam<ArgsType>>(Args)...);
         }
 
-    private:
         std::weak_ptr<Class> Weak;
         MethodType Method = nullptr;
-        FDelegateHandle Handle;
     };
 
     template <typename RetType, typename Func, typename... ArgsType>
-    class TLambdaDelegateInstance final : public TDelegateInstanceBase<RetType, ArgsType...>
+    class TLambdaDelegateInstance final : public TDelegateInstanceImpl<TLambdaDelegateInstance<RetType, Func, ArgsType...>, RetType, ArgsType...>
     {
+        friend TDelegateInstanceImpl<TLambdaDelegateInstance, RetType, ArgsType...>;
+
     public:
-        explicit TLambdaDelegateInstance(Func&& InFn)
-            : Fn(std::forward<Func>(InFn)), Handle(FDelegateHandle::GenerateNewHandle) {}
+        static_assert(std::is_same_v<Func, std::decay_t<Func>>, "TLambdaDelegateInstance expects a decayed callable type");
+        static_assert(std::is_invocable_r_v<RetType, Func&, TDelegateParam<ArgsType>...>, "Callable does not match the delegate signature");
 
-        __forceinline bool IsSafeToExecute() const override { return static_cast<bool>(Fn); }
-        __forceinline FDelegateHandle GetHandle() const override { return Handle; }
+        template <typename InFuncType>
+        explicit TLambdaDelegateInstance(InFuncType&& InFn) : Fn(std::forward<InFuncType>(InFn)) {}
 
-        RetType Execute(ArgsType... Args) override
+        // Nullable callables (function pointers, std::function) are checked; lambdas are always safe.
+        __forceinline bool IsSafeToExecute() const override
         {
-            assert(IsSafeToExecute());
-            if constexpr (std::is_void_v<RetType>) { Fn(std::forward<ArgsType>(Args)...); }
-            else { return Fn(std::forward<ArgsType>(Args)...); }
+            if constexpr (std::is_constructible_v<bool, const Func&>) return static_cast<bool>(Fn);
+            else return true;
         }
 
-        RetType ExecuteIfSafe(ArgsType... Args) override
+    private:
+        __forceinline Func* GetTarget() { return IsSafeToExecute() ? &Fn : nullptr; }
+
+        // The one place a result may need dropping: a callable returning a value can be bound to a void signature.
+        static __forceinline RetType Call(Func* InFn, TDelegateParam<ArgsType>... Args)
         {
-            if (!IsSafeToExecute())
-            {
-                if constexpr (!std::is_void_v<RetType>) return RetType{};
-                else return;
-            }
-            return Execute(std::forward<ArgsType>(Args)...);
+            if constexpr (std::is_void_v<RetType>) { (*InFn)(std::forward<TDelegateParam<ArgsType>>(Args)...); }
+            else { return (*InFn)(std::forward<TDelegateParam<ArgsType>>(Args)...); }
         }
 
-    private:
-        std::function<RetType(ArgsType...)> Fn;
-        FDelegateHandle Handle;
+        Func Fn;
     };
 
-    // ============================ TDelegate (unicast) ============================
-    template <typename Signature>
-    class TDelegate;
+    // ============================ TDelegateStorage ============================
 
-    template <typename RetType, typename... ArgsType>
-    class TDelegate<RetType(ArgsType...)>
+    // Instances up to this size are stored inside the delegate itself; larger ones (big lambda captures) are
+    // allocated through the Allocator policy (see DelegateAllocators.h).
+    // 40 bytes fits a weak binding on every ABI we build for and keeps a default TDelegate, handle included, at 64 bytes.
+    inline constexpr std::size_t DefaultDelegateInlineSize = 40;
+
+    // Owns one bound instance and calls it; TDelegate adds the handle. Multicast delegates keep their own handle per
+    // listener, so they store the listeners that need an instance as a bare TDelegateStorage.
+    template <typename Signature, std::size_t InlineSize = DefaultDelegateInlineSize, typename Allocator = FDelegateHeapAllocator>
+    class TDelegateStorage;
+
+    template <std::size_t InlineSize, typename Allocator, typename RetType, typename... ArgsType>
+    class TDelegateStorage<RetType(ArgsType...), InlineSize, Allocator>
     {
         using InstanceBase = TDelegateInstanceBase<RetType, ArgsType...>;
 
+        // An allocated instance leaves InlineStorage unused, so the function that destroys and frees it is kept there,
+        // along with its size.
+        using FDestroyFunc = void(*)(InstanceBase*) noexcept;
+
+        struct FAllocatedInstance
+        {
+            FDestroyFunc Destroy;
+            std::size_t Size;
+        };
+
+        static_assert(InlineSize >= sizeof(FAllocatedInstance), "InlineStorage must be able to hold the allocated instance's destroy function and size");
+
+        template <typename InstanceType>
+        static constexpr bool CanStoreInline =
+            sizeof(InstanceType) <= InlineSize && alignof(InstanceType) <= alignof(std::max_align_t) &&
+            std::is_nothrow_move_constructible_v<InstanceType>;
+
     public:
 
-        TDelegate() = default;
+        TDelegateStorage() = default;
+        ~TDelegateStorage() { Unbind(); }
+
+        TDelegateStorage(const TDelegateStorage&) = delete;
+        TDelegateStorage& operator=(const TDelegateStorage&) = delete;
+
+        TDelegateStorage(TDelegateStorage&& Other) noexcept { MoveFrom(Other); }
+        TDelegateStorage& operator=(TDelegateStorage&& Other) noexcept
+        {
+            if (this != &Other)
+            {
+                Unbind();
+                MoveFrom(Other);
+            }
+            return *this;
+        }
 
         __forceinline bool IsBound() const { return Instance != nullptr && Instance->IsSafeToExecute(); }
-        __forceinline void Unbind() { Instance.reset(); }
+        __forceinline bool IsStoredInline() const { return Instance != nullptr && IsInlineInstance(); }
+
+        void Unbind()
+        {
+            if (!Instance) return;
+
+            if (IsInlineInstance()) Instance->~InstanceBase();
+            else GetAllocatedInstance().Destroy(Instance);
+
+            Instance = nullptr;
+        }
+
+        // Bytes held by the binding: the delegate itself, plus its instance if that did not fit inline. Memory the
+        // bound callable owns (what a lambda's captures allocate) is not counted.
+        std::size_t GetMemoryFootprint() const
+        {
+            return sizeof(*this) + (Instance && !IsInlineInstance() ? GetAllocatedInstance().Size : 0);
+        }
+
+        // Releases a binding that can never execute again (its weak object expired), so its instance memory and the
+        // object's control block are not kept alive by an idle delegate.
+        void ShrinkToFit()
+        {
+            if (Instance && !Instance->IsSafeToExecute()) Unbind();
+        }
 
-        __forceinline FDelegateHandle GetHandle() const { return Instance ? Instance->GetHandle() : FDelegateHandle{}; }
+        __forceinline bool HasInstance() const { return Instance != nullptr; }
 
         void BindStatic(TFuncPtr<RetType(ArgsType...)> Func)
         {
-            Instance = std::make_shared<TStaticDelegateInstance<RetType, ArgsType...>>(Func);
+            Emplace<TStaticDelegateInstance<RetType, ArgsType...>>(Func);
         }
 
         template<typename Class>
         void AddRaw(Class* InObjPtr, TMemFuncPtr<Class, RetType(ArgsType...)> InMethod)
         {
-            Instance = std::make_shared<TRawDelegateInstance<Class, RetType, ArgsType...>>(InObjPtr, InMethod);
+            Emplace<TRawDelegateInstance<Class, RetType, ArgsType...>>(InObjPtr, InMethod);
         }
         template<typename Class>
         void AddRaw(const Class* InObjPtr, TMemFuncPtr<const Class, RetType(ArgsType...)> InMethod)
         {
-            Instance = std::make_shared<TRawDelegateInstance<const Class, RetType, ArgsType...>>(InObjPtr, InMethod);
+            Emplace<TRawDelegateInstance<const Class, RetType, ArgsType...>>(InObjPtr, InMethod);
         }
 
         // Bind weak_ptr
         template<typename Class>
         void AddWeak(std::weak_ptr<Class> InWeak, TMemFuncPtr<Class, RetType(ArgsType...)> InMethod)
         {
-            Instance = std::make_shared<TWeakDelegateInstance<Class, RetType, ArgsType...>>(InWeak, InMethod);
+            Emplace<TWeakDelegateInstance<Class, RetType, ArgsType...>>(InWeak, InMethod);
         }
         template<typename Class>
         void AddWeak(std::weak_ptr<const Class> InWeak, TMemFuncPtr<const Class, RetType(ArgsType...)> InMethod)
         {
-            Instance = std::make_shared<TWeakDelegateInstance<const Class, RetType, ArgsType...>>(InWeak, InMethod);
+            Emplace<TWeakDelegateInstance<const Class, RetType, ArgsType...>>(InWeak, InMethod);
         }
 
         template<typename Func>
         void AddLambda(Func&& InLambdaFunc)
         {
-            Instance = std::make_shared<TLambdaDelegateInstance<RetType, ArgsType..., Func>>(std::forward<Func>(InLambdaFunc));
+            Emplace<TLambdaDelegateInstance<RetType, std::decay_t<Func>, ArgsType...>>(std::forward<Func>(InLambdaFunc));
         }
 
-        RetType Execute(ArgsType... Args) const
+        RetType Execute(TDelegateParam<ArgsType>... Args) const
         {
             assert(IsBound());
-            return Instance->Execute(std::forward<ArgsType>(Args)...);
+            return Instance->Execute(std::forward<TDelegateParam<ArgsType>>(Args)...);
+        }
+
+        RetType ExecuteIfBound(TDelegateParam<ArgsType>... Args) const
+        {
+            if (!Instance) return RetType();
+            return Instance->ExecuteIfSafe(std::forward<TDelegateParam<ArgsType>>(Args)...);
+        }
+
+        // ExecuteIfBound for callers that only need to know whether the call happened.
+        __forceinline bool TryExecute(TDelegateParam<ArgsType>... Args) const
+        {
+            return Instance != nullptr && Instance->TryExecute(std::forward<TDelegateParam<ArgsType>>(Args)...);
+        }
+
+        __forceinline std::shared_ptr<const void> PinObject() const { return Instance ? Instance->PinObject() : nullptr; }
+
+        // InPinnedObject must come from PinObject() of this binding and still be alive.
+        __forceinline RetType ExecutePinned(const void* InPinnedObject, TDelegateParam<ArgsType>... Args) const
+        {
+            assert(Instance && InPinnedObject);
+            return Instance->ExecutePinned(InPinnedObject, std::forward<TDelegateParam<ArgsType>>(Args)...);
+        }
+
+    private:
+        template <typename InstanceType, typename... CtorArgsType>
+        void Emplace(CtorArgsType&&... CtorArgs)
+        {
+            Unbind();
+
+            if constexpr (CanStoreInline<InstanceType>)
+            {
+                Instance = new (InlineStorage) InstanceType(std::forward<CtorArgsType>(CtorArgs)...);
+                assert(IsInlineInstance());
+            }
+            else
+            {
+                void* Memory = Allocator::Allocate(sizeof(InstanceType), alignof(InstanceType));
+                try
+                {
+                    Instance = new (Memory) InstanceType(std::forward<CtorArgsType>(CtorArgs)...);
+                }
+                catch (...)
+                {
+                    Allocator::Free(Memory, sizeof(InstanceType), alignof(InstanceType));
+                    throw;
+                }
+                SetAllocatedInstance({ &DestroyAllocated<InstanceType>, sizeof(InstanceType) });
+            }
+        }
+
+        template <typename InstanceType>
+        static void DestroyAllocated(InstanceBase* InInstance) noexcept
+        {
+            InstanceType* Typed = static_cast<InstanceType*>(InInstance);
+            Typed->~InstanceType();
+            Allocator::Free(Typed, sizeof(InstanceType), alignof(InstanceType));
         }
 
-        RetType ExecuteIfBound(ArgsType... Args) const
+        __forceinline const FAllocatedInstance& GetAllocatedInstance() const { return *std::launder(reinterpret_cast<const FAllocatedInstance*>(InlineStorage)); }
+        __forceinline void SetAllocatedInstance(const FAllocatedInstance& InAllocated) { new (InlineStorage) FAllocatedInstance(InAllocated); }
+
+        // Instances derive from TDelegateInstanceBase alone, so the base pointer is the address the instance was built at.
+        __forceinline bool IsInlineInstance() const { return static_cast<const void*>(Instance) == InlineStorage; }
+
+        void MoveFrom(TDelegateStorage& Other) noexcept
         {
-            if (!IsBound())
+            if (!Other.Instance) return;
+
+            if (Other.IsInlineInstance())
+            {
+                Instance = Other.Instance->MoveTo(InlineStorage);
+                Other.Unbind();
+            }
+            else
             {
-                if constexpr (!std::is_void_v<RetType>) return RetType{};
-                else return;
+                Instance = Other.Instance;
+                SetAllocatedInstance(Other.GetAllocatedInstance());
+                Other.Instance = nullptr;
             }
-            return Instance->Execute(std::forward<ArgsType>(Args)...);
         }
 
     private:
-        std::shared_ptr<InstanceBase> Instance;
+        alignas(std::max_align_t) unsigned char InlineStorage[InlineSize];
+        InstanceBase* Instance = nullptr;
     };
 
-    // ======================= TMulticastDelegate (multicast) =======================
+    // ============================ TDelegate (unicast) ============================
 
-    template <typename Signature>
-    class TMulticastDelegate;
+    // A TDelegateStorage plus the handle of its binding: every bind generates a new handle, Unbind resets it.
+    template <typename Signature, std::size_t InlineSize = DefaultDelegateInlineSize, typename Allocator = FDelegateHeapAllocator>
+    class TDelegate;
 
-    template <typename RetType, typename... ArgsType>
-class TMulticastDelegate<RetType(ArgsType...)>
+    template <std::size_t InlineSize, typename Allocator, typename RetType, typename... ArgsType>
+    class TDelegate<RetType(ArgsType...), InlineSize, Allocator> : public TDelegateStorage<RetType(ArgsType...), InlineSize, Allocator>
     {
-        using Unicast = TDelegate<RetType(ArgsType...)>;
+        using Super = TDelegateStorage<RetType(ArgsType...), InlineSize, Allocator>;
+
+    public:
+        TDelegate() = default;
 
-        struct FEntry
+        TDelegate(TDelegate&& Other) noexcept : Super(std::move(Other)), Handle(Other.Handle) { Other.Handle.Reset(); }
+        TDelegate& operator=(TDelegate&& Other) noexcept
         {
-            FDelegateHandle Handle;
-            Unicast Delegate;
-            void* Owner = nullptr;
-        };
+            if (this != &Other)
+            {
+                Super::operator=(std::move(Other));
+                Handle = Other.Handle;
+                Other.Handle.Reset();
+            }
+            return *this;
+        }
 
-    public:
-        __forceinline bool IsBound() const { return !Entries.empty(); }
-        __forceinline void Clear() { Entries.clear(); }
+        __forceinline FDelegateHandle GetHandle() const { return Handle; }
+
+        void Unbind()
+        {
+            Super::Unbind();
+            Handle.Reset();
+        }
+
+        std::size_t GetMemoryFootprint() const { return Super::GetMemoryFootprint() + (sizeof(TDelegate) - sizeof(Super)); }
+
+        void ShrinkToFit()
+        {
+            Super::ShrinkToFit();
+            if (!this->HasInstance()) Handle.Reset();
+        }
 
-        FDelegateHandle AddStatic(TFuncPtr<RetType(ArgsType...)> Fn)
+        void BindStatic(TFuncPtr<RetType(ArgsType...)> Func)
         {
-            Unicast D; D.BindStatic(Fn);
-            return AddInternal(std::move(D), nullptr);
+            Super::BindStatic(Func);
+            Handle = FDelegateHandle(FDelegateHandle::GenerateNewHandle);
         }
 
         template<typename Class>
-        FDelegateHandle AddRaw(Class* InObjPtr, TMemFuncPtr<Class, RetType(ArgsType...)> InMethod)
+        void AddRaw(Class* InObjPtr, TMemFuncPtr<Class, RetType(ArgsType...)> InMethod)
         {
-            Unicast Delegate; Delegate.AddRaw(InObjPtr, InMethod);
-            return AddInternal(std::move(Delegate), InObjPtr);
+            Super::AddRaw(InObjPtr, InMethod);
+            Handle = FDelegateHandle(FDelegateHandle::GenerateNewHandle);
         }
         template<typename Class>
-        FDelegateHandle AddRaw(const Class* InObjPtr, TMemFuncPtr<const Class, RetType(ArgsType...)> InMethod)
+        void AddRaw(const Class* InObjPtr, TMemFuncPtr<const Class, RetType(ArgsType...)> InMethod)
         {
-            Unicast Delegate; Delegate.AddRaw(InObjPtr, InMethod);
-            return AddInternal(std::move(Delegate), const_cast<Class*>(InObjPtr));
+            Super::AddRaw(InObjPtr, InMethod);
+            Handle = FDelegateHandle(FDelegateHandle::GenerateNewHandle);
         }
 
         template<typename Class>
-        FDelegateHandle AddWeak(std::weak_ptr<Class> InWeak, TMemFuncPtr<Class, RetType(ArgsType...)> InMethod)
+        void AddWeak(std::weak_ptr<Class> InWeak, TMemFuncPtr<Class, RetType(ArgsType...)> InMethod)
         {
-            Unicast Delegate; Delegate.AddWeak(InWeak, InMethod);
-            return AddInternal(std::move(Delegate), nullptr);
+            Super::AddWeak(std::move(InWeak), InMethod);
+            Handle = FDelegateHandle(FDelegateHandle::GenerateNewHandle);
         }
         template<typename Class>
-        FDelegateHandle AddWeak(std::weak_ptr<const Class> InWeak, TMemFuncPtr<const Class, RetType(ArgsType...)> InMethod)
+        void AddWeak(std::weak_ptr<const Class> InWeak, TMemFuncPtr<const Class, RetType(ArgsType...)> InMethod)
         {
-            Unicast Delegate; Delegate.AddWeak(InWeak, InMethod);
-            return AddInternal(std::move(Delegate), nullptr);
+            Super::AddWeak(std::move(InWeak), InMethod);
+            Handle = FDelegateHandle(FDelegateHandle::GenerateNewHandle);
         }
 
         template<typename Func>
-        FDelegateHandle AddLambda(Func&& InFunc)
+        void AddLambda(Func&& InLambdaFunc)
         {
-            Unicast Delegate; Delegate.AddLambda(std::forward<Func>(InFunc));
-            return AddInternal(std::move(Delegate), nullptr);
+            Super::AddLambda(std::forward<Func>(InLambdaFunc));
+            Handle = FDelegateHandle(FDelegateHandle::GenerateNewHandle);
         }
 
-        void Remove(FDelegateHandle InHandle)
+    private:
+        FDelegateHandle Handle;
+    };
+
+    // ======================= Bind Options =======================
+
+    enum class EDelegateAffinity : uint8_t
+    {
+        // Only ever called on the broadcasting thread (the default).
+        CallerThread,
+        // Thread-safe: ParallelBroadcast may call it on a worker thread.
+        AnyThread,
+    };
+
+    // Optional last argument of the multicast Add* functions; converts from a plain priority.
+    //
+    //   OnWorldEvent.AddRaw(&Agent, &FAgent::React, FDelegateBindOptions::AnyThread());
+    struct FDelegateBindOptions
+    {
+        FDelegateBindOptions() = default;
+        FDelegateBindOptions(int32_t InPriority) : Priority(InPriority) {}
+
+        static FDelegateBindOptions AnyThread(int32_t InPriority = 0)
         {
-            auto Iter = std::find_if(Entries.begin(), Entries.end(),
-                [&](const FEntry& E)
-                {
-                    return E.Handle == InHandle;
-                });
+            FDelegateBindOptions Options(InPriority);
+            Options.Affinity = EDelegateAffinity::AnyThread;
+            return Options;
+        }
 
-            if (Iter != Entries.end()) Entries.erase(Iter);
+        // InDebugName must outlive the binding (a string literal).
+        FDelegateBindOptions& Named(const char* InDebugName)
+        {
+            DebugName = InDebugName;
+            return *this;
         }
 
-        void RemoveAll(const void* InOwner)
+        // The listener only hears BroadcastKeyed calls with this key, e.g. its entity ID or channel (and plain Broadcast).
+        FDelegateBindOptions& Filtered(uint32_t InFilterKey)
         {
-            if (!InOwner) return;
+            assert(InFilterKey != NoFilterKey);
+            FilterKey = InFilterKey;
+            return *this;
+        }
+
+        static constexpr uint32_t NoFilterKey = UINT32_MAX;
+
+        // Listeners are called from the highest priority down; equal priorities keep the order they were added in.
+        // The order is kept by inserting at Add, so Broadcast stays a single pass.
+        int32_t Priority = 0;
+        EDelegateAffinity Affinity = EDelegateAffinity::CallerThread;
+
+        // Names the listener in stats reports (DelegateStats.h); unused unless DELEGATES_WITH_STATS is set.
+        const char* DebugName = nullptr;
+
+        // Unfiltered listeners hear every BroadcastKeyed call, whatever its key.
+        uint32_t FilterKey = NoFilterKey;
+    };
 
-            Entries.erase(
-                std::remove_if(Entries.begin(), Entries.end(),
-                    [&](const FEntry& E){ return E.Owner == InOwner; }),
-                Entries.end());
+    // ======================= Reducers =======================
+
+    // Short-circuiting reducers for TMulticastDelegate::BroadcastReduce. A reducer folds one return value into the
+    // accumulator; IsDone tells the broadcast that no later listener can change the result.
+    struct FAnyTrue
+    {
+        __forceinline bool operator()(bool InAccumulator, bool InValue) const { return InAccumulator || InValue; }
+        __forceinline bool IsDone(bool InAccumulator) const { return InAccumulator; }
+    };
+
+    struct FAllTrue
+    {
+        __forceinline bool operator()(bool InAccumulator, bool InValue) const { return InAccumulator && InValue; }
+        __forceinline bool IsDone(bool InAccumulator) const { return !InAccumulator; }
+    };
+
+    // Keeps the first value that differs from a value-initialized T.
+    struct FFirstNonDefault
+    {
+        template <typename T, typename ValueType>
+        __forceinline T operator()(T InAccumulator, ValueType&& InValue) const
+        {
+            if (IsDone(InAccumulator)) return InAccumulator;
+            return T(std::forward<ValueType>(InValue));
         }
 
-        void Broadcast(ArgsType... Args)
+        template <typename T>
+        __forceinline bool IsDone(const T& InAccumulator) const { return !(InAccumulator == T{}); }
+    };
+
+    // ======================= TScopedDelegateHandle =======================
+
+    // Move-only subscription returned by the AddScoped* functions of a multicast delegate: destroying or resetting it
+    // unbinds the listener through the handle's slot, without searching. Handles are linked into their delegate, which
+    // detaches them when it is destroyed first; a detached handle does nothing.
+    template <typename DelegateType>
+    class TScopedDelegateHandle
+    {
+    public:
+        TScopedDelegateHandle() = default;
+        ~TScopedDelegateHandle() { Reset(); }
+
+        TScopedDelegateHandle(TScopedDelegateHandle&& Other) noexcept { TakeFrom(Other); }
+        TScopedDelegateHandle& operator=(TScopedDelegateHandle&& Other) noexcept
         {
-            if (Entries.empty()) return;
+            if (this != &Other)
+            {
+                Reset();
+                TakeFrom(Other);
+            }
+            return *this;
+        }
+
+        TScopedDelegateHandle(const TScopedDelegateHandle&) = delete;
+        TScopedDelegateHandle& operator=(const TScopedDelegateHandle&) = delete;
+
+        __forceinline bool IsValid() const { return Delegate != nullptr; }
+        __forceinline FDelegateHandle GetHandle() const { return Handle; }
 
-            auto Snapshot = Entries;
-            for (const FEntry& Entry : Snapshot)
+        // Unbinds the listener now.
+        void Reset()
+        {
+            if (DelegateType* Owner = Delegate)
             {
-                Entry.Delegate.ExecuteIfBound(std::forward<ArgsType>(Args)...);
+                Unlink();
+                Owner->Remove(Handle);
             }
+            Handle.Reset();
+        }
+
+        // Gives up the subscription without unbinding; the listener can still be removed with the returned handle.
+        FDelegateHandle Release()
+        {
+            if (Delegate) Unlink();
 
-            Entries.erase(
-                std::remove_if(Entries.begin(), Entries.end(),
-                    [](const FEntry& Entry){ return !Entry.Delegate.IsBound(); }),
-                Entries.end());
+            const FDelegateHandle Result = Handle;
+            Handle.Reset();
+            return Result;
+        }
+
+    private:
+        friend DelegateType;
+
+        TScopedDelegateHandle(DelegateType& InDelegate, FDelegateHandle InHandle)
+            : Handle(InHandle)
+        {
+            if (Handle.IsValid()) Link(InDelegate);
+        }
+
+        void Link(DelegateType& InDelegate)
+        {
+            Delegate = &InDelegate;
+            Next = InDelegate.ScopedHandles;
+            if (Next) Next->Prev = this;
+            InDelegate.ScopedHandles = this;
+        }
+
+        void Unlink()
+        {
+            if (Prev) Prev->Next = Next;
+            else Delegate->ScopedHandles = Next;
+            if (Next) Next->Prev = Prev;
+
+            Delegate = nullptr;
+            Prev = nullptr;
+            Next = nullptr;
+        }
+
+        void TakeFrom(TScopedDelegateHandle& Other)
+        {
+            Handle = Other.Handle;
+            if (DelegateType* OtherDelegate = Other.Delegate)
+            {
+                Other.Unlink();
+                Link(*OtherDelegate);
+            }
+            Other.Handle.Reset();
         }
 
     private:
-        FDelegateHandle AddInternal(Unicast&& InDelegate, void* InOwner)
+        DelegateType* Delegate = nullptr;
+        FDelegateHandle Handle;
+
+        TScopedDelegateHandle* Prev = nullptr;
+        TScopedDelegateHandle* Next = nullptr;
+    };
+
+    // ======================= TBroadcastAwaiter =======================
+
+    // Awaitable returned by TMulticastDelegate::Next(): `co_await OnHealthChanged.Next()` suspends the coroutine until the
+    // next Broadcast, ParallelBroadcast or flushed event, then resumes it on the broadcasting thread, after the listeners,
+    // with a copy of the arguments as a tuple. The awaiter lives in the coroutine frame and is linked into the delegate
+    // while waiting, so waiting allocates nothing. Destroying a waiting coroutine unlinks it; one still waiting when its
+    // delegate is destroyed is never resumed. A resumed coroutine may destroy the delegate (a one-shot event's owner
+    // going away), unless the broadcast resuming it was made from one of the delegate's own listeners; the waiters not
+    // yet resumed are then dropped.
+    template <typename DelegateType>
+    class TBroadcastAwaiter
+    {
+    public:
+        using FEventArgs = typename DelegateType::FEventArgs;
+
+        ~TBroadcastAwaiter() { if (bWaiting) Unlink(); }
+
+        TBroadcastAwaiter(const TBroadcastAwaiter&) = delete;
+        TBroadcastAwaiter& operator=(const TBroadcastAwaiter&) = delete;
+
+        __forceinline bool await_ready() const noexcept { return false; }
+
+        void await_suspend(std::coroutine_handle<> InCoroutine) noexcept
+        {
+            Coroutine = InCoroutine;
+            Generation = Delegate.AwaitGeneration;
+            Link();
+        }
+
+        // Called as the coroutine resumes, while the broadcast still holds the arguments.
+        FEventArgs await_resume() const
         {
-            FEntry Entry;
-            Entry.Handle = InDelegate.GetHandle();
+            assert(Event);
+            return *Event;
+        }
+
+    private:
+        friend DelegateType;
 
-            if (!Entry.Handle.IsValid()) Entry.Handle = FDelegateHandle(FDelegateHandle::GenerateNewHandle);
+        explicit TBroadcastAwaiter(DelegateType& InDelegate) : Delegate(InDelegate) {}
 
-            Entry.Delegate = std::move(InDelegate);
-            Entry.Owner = InOwner;
-            Entries.emplace_back(std::move(Entry));
+        // Appended, so the delegate resumes waiters oldest first.
+        void Link()
+        {
+            Prev = Delegate.AwaitersTail;
+            if (Prev) Prev->Next = this;
+            else Delegate.AwaitersHead = this;
+            Delegate.AwaitersTail = this;
+            bWaiting = true;
+        }
 
-            return Entries.back().Handle;
+        void Unlink()
+        {
+            if (Prev) Prev->Next = Next;
+            else Delegate.AwaitersHead = Next;
+            if (Next) Next->Prev = Prev;
+            else Delegate.AwaitersTail = Prev;
+
+            Prev = nullptr;
+            Next = nullptr;
+            bWaiting = false;
         }
 
     private:
-        std::vector<FEntry> Entries;
+        DelegateType& Delegate;
+        std::coroutine_handle<> Coroutine;
+        const FEventArgs* Event = nullptr;
+        uint64_t Generation = 0;
+        bool bWaiting = false;
+
+        TBroadcastAwaiter* Prev = nullptr;
+        TBroadcastAwaiter* Next = nullptr;
+    };
+
+    // ======================= TMulticastDelegate (multicast) =======================
+
+    // Allocator is used for heap-stored listener instances and, unless it is frame scoped, for every listener array
+    // (see DelegateAllocators.h).
+    template <typename Signature, typename Allocator = FDelegateHeapAllocator>
+    class TMulticastDelegate;
+
+    template <typename Allocator, typename RetType, typename... ArgsType>
+    class TMulticastDelegate<RetType(ArgsType...), Allocator>
+    {
+        // Generic listeners' instances; their handle lives in FBindingInfo only.
+        using Unicast = TDelegateStorage<RetType(ArgsType...), DefaultDelegateInlineSize, Allocator>;
+
+        template <typename T>
+        using TArray = TDelegateVector<T, Allocator>;
+
+        struct FBinding;
+
+        // Where a thunk leaves the listener's return value for BroadcastReduce; plain Broadcast passes nullptr.
+        using FResult = std::conditional_t<std::is_reference_v<RetType>, std::reference_wrapper<std::remove_reference_t<RetType>>, RetType>;
+        using FResultSlot = std::optional<std::conditional_t<std::is_void_v<RetType>, char, FResult>>;
+
+        // The arguments reach a thunk as one pointer whatever the arity. When every parameter travels by value (void(),
+        // scalars, small PODs; see TDelegateParam) they are copied once per broadcast into a single pack; otherwise the
+        // pack refers to the caller's arguments.
+        static constexpr bool bPackArgsByValue = ((!std::is_reference_v<ArgsType> && std::is_same_v<TDelegateParam<ArgsType>, ArgsType>) && ...);
+        using FThunkArgs = std::conditional_t<bPackArgsByValue, std::tuple<std::decay_t<ArgsType>...>, std::tuple<TDelegateParam<ArgsType>&...>>;
+
+        // Calls one listener; returns false if the binding turned out dead (e.g. an expired weak object).
+        using FThunk = bool(*)(TMulticastDelegate& InSelf, const FBinding& InBinding, FResultSlot* OutResult, const FThunkArgs& InArgs);
+
+        // Listeners are stored as parallel arrays. Bindings is all Broadcast reads: raw, static and small trivially
+        // copyable lambda listeners are called straight from it; other kinds (weak, capturing by value, const raw) keep
+        // a TDelegateStorage in GenericDelegates and store its index as their target. Infos holds what only Add/Remove/Compact need.
+        struct FBinding
+        {
+            // Null once the listener is removed.
+            FThunk Thunk = nullptr;
+            void* Object = nullptr;
+            // Member or free function pointer, the lambda itself, or the GenericDelegates index.
+            alignas(void*) unsigned char Target[16] = {};
+        };
+
+        struct FBindingInfo
+        {
+            FDelegateHandle Handle;
+            const void* Owner = nullptr;
+            uint32_t GenericIndex = UINT32_MAX;
+            int32_t Priority = 0;
+            uint32_t FilterKey = FDelegateBindOptions::NoFilterKey;
+            EDelegateAffinity Affinity = EDelegateAffinity::CallerThread;
+            bool bRemoved = false;
+#if DELEGATES_WITH_STATS
+            const char* DebugName = nullptr;
+#endif
+        };
+
+        struct FPendingAdd
+        {
+            FBinding Binding;
+            FBindingInfo Info;
+            Unicast Delegate;
+        };
+
+    public:
+        using FEventArgs = std::tuple<std::decay_t<ArgsType>...>;
+        using FEventBatch = std::span<const FEventArgs>;
+
+    private:
+        // Batch listeners and awaiting coroutines receive a copy of each broadcast's arguments, so signatures with
+        // move-only arguments can't have them.
+        static constexpr bool bCanCopyEvents = std::is_copy_constructible_v<FEventArgs>;
+
+        using BatchUnicast = TDelegate<void(FEventBatch), DefaultDelegateInlineSize, Allocator>;
+
+        // Batch listeners are few; each is heap allocated so it stays put when the array grows mid-broadcast.
+        // The handle is the delegate's own; batch delegates are never unbound while their entry lives.
+        struct FBatchEntry
+        {
+            BatchUnicast Delegate;
+            const void* Owner = nullptr;
+            bool bRemoved = false;
+        };
+
+        // The listener arrays are iterated in place, so while any Broadcast is running they must not
+        // grow or shrink: adds are queued in PendingAdds and removes only mark the listener.
+        // Both are applied once the outermost Broadcast returns.
+        struct FBroadcastScope
+        {
+            explicit FBroadcastScope(TMulticastDelegate& InOwner) : Owner(InOwner) { ++Owner.BroadcastDepth; }
+            ~FBroadcastScope() { if (--Owner.BroadcastDepth == 0) Owner.ApplyPending(); }
+
+            FBroadcastScope(const FBroadcastScope&) = delete;
+            FBroadcastScope& operator=(const FBroadcastScope&) = delete;
+
+            TMulticastDelegate& Owner;
+        };
+
+        static constexpr uint32_t InvalidIndex = UINT32_MAX;
+
+        // Per-slot links of the intrusive list of each owner's live listeners, headed in OwnerHeads.
+        struct FOwnerLink
+        {
+            uint32_t Prev = InvalidIndex;
+            uint32_t Next = InvalidIndex;
+        };
+
+        using FOwnerHeadMap = std::unordered_map<const void*, uint32_t, std::hash<const void*>, std::equal_to<const void*>,
+            TDelegateContainerAllocator<std::pair<const void* const, uint32_t>, Allocator>>;
+
+    public:
+        using FScopedHandle = TScopedDelegateHandle<TMulticastDelegate>;
+        using FAwaiter = TBroadcastAwaiter<TMulticastDelegate>;
+
+        // Fraction of removed or dead listeners above which the arrays are compacted.
+        static constexpr float DefaultCompactionThreshold = 0.5f;
+
+        // Locks every weak listener once for the lifetime of the scope, so repeated broadcasts inside it (several
+        // events in one tick) call them through the pinned pointers without touching their control blocks.
+        // Pinned objects are kept alive until the scope ends. The scope counts as a running broadcast: adds and
+        // removes made inside it are applied when it ends, and listeners added inside it are not pinned.
+        //
+        //   { FOnHealthChanged::FWeakPinScope Pin(OnHealthChanged); for (...) OnHealthChanged.Broadcast(...); }
+        class FWeakPinScope
+        {
+        public:
+            explicit FWeakPinScope(TMulticastDelegate& InOwner) : Owner(InOwner) { Owner.BeginPin(); }
+            ~FWeakPinScope() { Owner.EndPin(); }
+
+            FWeakPinScope(const FWeakPinScope&) = delete;
+            FWeakPinScope& operator=(const FWeakPinScope&) = delete;
+
+        private:
+            TMulticastDelegate& Owner;
+        };
+
+        TMulticastDelegate() = default;
+        explicit TMulticastDelegate(const char* InDebugName) : DebugName(InDebugName) {}
+
+        // Outstanding scoped handles are detached, so they don't unbind from a destroyed delegate; so are waiting coroutines.
+        // A ResumeAwaiters running further up the stack (the delegate destroyed by a coroutine it resumed) is told to stop.
+        ~TMulticastDelegate()
+        {
+            while (ScopedHandles) ScopedHandles->Unlink();
+            while (AwaitersHead) AwaitersHead->Unlink();
+            for (FResumeScope* Scope = ResumeScopes; Scope; Scope = Scope->Outer) Scope->bDelegateDestroyed = true;
+        }
+
+        // Scoped handles and pin scopes refer to the delegate by address, so it stays put.
+        TMulticastDelegate(const TMulticastDelegate&) = delete;
+        TMulticastDelegate& operator=(const TMulticastDelegate&) = delete;
+
+        __forceinline bool IsBound() const { return Bindings.size() + PendingAdds.size() > NumRemoved || !BatchEntries.empty(); }
+        __forceinline bool IsBroadcasting() const { return BroadcastDepth > 0; }
+
+        // Names the delegate in stats reports and the debugger. InDebugName must outlive the delegate (a string literal).
+        __forceinline void SetDebugName(const char* InDebugName) { DebugName = InDebugName; }
+        __forceinline const char* GetDebugName() const { return DebugName; }
+
+        void Clear()
+        {
+            if (IsBroadcasting())
+            {
+                for (size_t Index = 0; Index < Bindings.size(); ++Index) MarkRemoved(Index);
+                for (FPendingAdd& Pending : PendingAdds) MarkRemoved(Pending);
+                for (auto& Entry : BatchEntries) Entry->bRemoved = true;
+                return;
+            }
+
+            Bindings.clear();
+            Infos.clear();
+            FilterKeys.clear();
+            GenericDelegates.clear();
+            FreeGenericSlots.clear();
+            DeferredGenericReleases.clear();
+            BatchEntries.clear();
+            SlotToIndex.clear();
+            FreeSlots.clear();
+            OwnerLinks.clear();
+            OwnerHeads.clear();
+            NumRemoved = 0;
+        }
+
+        FDelegateHandle AddStatic(TFuncPtr<RetType(ArgsType...)> Fn, const FDelegateBindOptions& InOptions = {})
+        {
+            FBinding Binding;
+            Binding.Thunk = &CallStatic;
+            std::memcpy(Binding.Target, &Fn, sizeof(Fn));
+            return AddInternal(Binding, FDelegateHandle(FDelegateHandle::GenerateNewHandle), nullptr, InOptions);
+        }
+
+        template<typename Class>
+        FDelegateHandle AddRaw(Class* InObjPtr, TMemFuncPtr<Class, RetType(ArgsType...)> InMethod, const FDelegateBindOptions& InOptions = {})
+        {
+            using MethodType = TMemFuncPtr<Class, RetType(ArgsType...)>;
+
+            // Member pointers wider than Target (virtual inheritance on some ABIs) take the generic path.
+            if constexpr (sizeof(MethodType) <= sizeof(FBinding::Target))
+            {
+                FBinding Binding;
+                Binding.Thunk = &CallRaw<Class>;
+                Binding.Object = InObjPtr;
+                std::memcpy(Binding.Target, &InMethod, sizeof(InMethod));
+                return AddInternal(Binding, FDelegateHandle(FDelegateHandle::GenerateNewHandle), InObjPtr, InOptions);
+            }
+            else
+            {
+                Unicast Delegate; Delegate.AddRaw(InObjPtr, InMethod);
+                return AddGeneric(std::move(Delegate), InObjPtr, InOptions);
+            }
+        }
+        template<typename Class>
+        FDelegateHandle AddRaw(const Class* InObjPtr, TMemFuncPtr<const Class, RetType(ArgsType...)> InMethod, const FDelegateBindOptions& InOptions = {})
+        {
+            Unicast Delegate; Delegate.AddRaw(InObjPtr, InMethod);
+            return AddGeneric(std::move(Delegate), InObjPtr, InOptions);
+        }
+
+        // AddStatic/AddRaw with the function fixed at compile time: the listener's thunk is instantiated for it and calls
+        // it directly rather than through a stored pointer. Works for const objects too, without the generic path.
+        //
+        //   Player.OnHealthChanged.AddRaw<&Logger::Update>(&Log);
+        template <auto Function>
+        FDelegateHandle AddStatic(const FDelegateBindOptions& InOptions = {})
+        {
+            static_assert(std::is_same_v<decltype(Function), TFuncPtr<RetType(ArgsType...)>>, "Function does not match the delegate signature");
+
+            FBinding Binding;
+            Binding.Thunk = &CallStaticFunction<Function>;
+            return AddInternal(Binding, FDelegateHandle(FDelegateHandle::GenerateNewHandle), nullptr, InOptions);
+        }
+
+        template <auto Method, typename Class>
+        FDelegateHandle AddRaw(Class* InObjPtr, const FDelegateBindOptions& InOptions = {})
+        {
+            static_assert(std::is_member_function_pointer_v<decltype(Method)>, "AddRaw<Method> expects a member function");
+            static_assert(std::is_invocable_r_v<RetType, decltype(Method), Class*, TDelegateParam<ArgsType>...>, "Method does not match the delegate signature");
+
+            FBinding Binding;
+            Binding.Thunk = &CallRawMethod<Method, Class>;
+            Binding.Object = const_cast<void*>(static_cast<const void*>(InObjPtr));
+            return AddInternal(Binding, FDelegateHandle(FDelegateHandle::GenerateNewHandle), InObjPtr, InOptions);
+        }
+
+        // The weak object is the owner, for RemoveAll.
+        template<typename Class>
+        FDelegateHandle AddWeak(std::weak_ptr<Class> InWeak, TMemFuncPtr<Class, RetType(ArgsType...)> InMethod, const FDelegateBindOptions& InOptions = {})
+        {
+            const void* Owner = InWeak.lock().get();
+            Unicast Delegate; Delegate.AddWeak(InWeak, InMethod);
+            return AddGeneric(std::move(Delegate), Owner, InOptions);
+        }
+        template<typename Class>
+        FDelegateHandle AddWeak(std::weak_ptr<const Class> InWeak, TMemFuncPtr<const Class, RetType(ArgsType...)> InMethod, const FDelegateBindOptions& InOptions = {})
+        {
+            const void* Owner = InWeak.lock().get();
+            Unicast Delegate; Delegate.AddWeak(InWeak, InMethod);
+            return AddGeneric(std::move(Delegate), Owner, InOptions);
+        }
+
+        template<typename Func>
+        FDelegateHandle AddLambda(Func&& InFunc, const FDelegateBindOptions& InOptions = {})
+        {
+            return AddLambda(nullptr, std::forward<Func>(InFunc), InOptions);
+        }
+
+        // InOwner only tags the listener, so RemoveAll(InOwner) removes it along with the owner's other bindings.
+        template<typename Func>
+        FDelegateHandle AddLambda(const void* InOwner, Func&& InFunc, const FDelegateBindOptions& InOptions = {})
+        {
+            using FuncType = std::decay_t<Func>;
+
+            if constexpr (CanStoreInBinding<FuncType>)
+            {
+                static_assert(std::is_invocable_r_v<RetType, FuncType&, TDelegateParam<ArgsType>...>, "Callable does not match the delegate signature");
+
+                FBinding Binding;
+                Binding.Thunk = &CallLambda<FuncType>;
+                new (Binding.Target) FuncType(std::forward<Func>(InFunc));
+                return AddInternal(Binding, FDelegateHandle(FDelegateHandle::GenerateNewHandle), InOwner, InOptions);
+            }
+            else
+            {
+                Unicast Delegate; Delegate.AddLambda(std::forward<Func>(InFunc));
+                return AddGeneric(std::move(Delegate), InOwner, InOptions);
+            }
+        }
+
+        // Opt-in RAII variants of the Add functions: the listener stays bound as long as the returned handle lives.
+        [[nodiscard]] FScopedHandle AddScopedStatic(TFuncPtr<RetType(ArgsType...)> Fn, const FDelegateBindOptions& InOptions = {})
+        {
+            return FScopedHandle(*this, AddStatic(Fn, InOptions));
+        }
+
+        template<typename Class>
+        [[nodiscard]] FScopedHandle AddScopedRaw(Class* InObjPtr, TMemFuncPtr<Class, RetType(ArgsType...)> InMethod, const FDelegateBindOptions& InOptions = {})
+        {
+            return FScopedHandle(*this, AddRaw(InObjPtr, InMethod, InOptions));
+        }
+        template<typename Class>
+        [[nodiscard]] FScopedHandle AddScopedRaw(const Class* InObjPtr, TMemFuncPtr<const Class, RetType(ArgsType...)> InMethod, const FDelegateBindOptions& InOptions = {})
+        {
+            return FScopedHandle(*this, AddRaw(InObjPtr, InMethod, InOptions));
+        }
+
+        template<typename Class>
+        [[nodiscard]] FScopedHandle AddScopedWeak(std::weak_ptr<Class> InWeak, TMemFuncPtr<Class, RetType(ArgsType...)> InMethod, const FDelegateBindOptions& InOptions = {})
+        {
+            return FScopedHandle(*this, AddWeak(std::move(InWeak), InMethod, InOptions));
+        }
+        template<typename Class>
+        [[nodiscard]] FScopedHandle AddScopedWeak(std::weak_ptr<const Class> InWeak, TMemFuncPtr<const Class, RetType(ArgsType...)> InMethod, const FDelegateBindOptions& InOptions = {})
+        {
+            return FScopedHandle(*this, AddWeak(std::move(InWeak), InMethod, InOptions));
+        }
+
+        template<typename Func>
+        [[nodiscard]] FScopedHandle AddScopedLambda(Func&& InFunc, const FDelegateBindOptions& InOptions = {})
+        {
+            return FScopedHandle(*this, AddLambda(std::forward<Func>(InFunc), InOptions));
+        }
+        template<typename Func>
+        [[nodiscard]] FScopedHandle AddScopedLambda(const void* InOwner, Func&& InFunc, const FDelegateBindOptions& InOptions = {})
+        {
+            return FScopedHandle(*this, AddLambda(InOwner, std::forward<Func>(InFunc), InOptions));
+        }
+
+        // Batch listeners receive every event as one span: all queued events on Flush, a single event on Broadcast.
+        template<typename Class>
+        FDelegateHandle AddBatchRaw(Class* InObjPtr, TMemFuncPtr<Class, void(FEventBatch)> InMethod)
+        {
+            BatchUnicast Delegate; Delegate.AddRaw(InObjPtr, InMethod);
+            return AddBatchInternal(std::move(Delegate), InObjPtr);
+        }
+
+        template<typename Func>
+        FDelegateHandle AddBatchLambda(Func&& InFunc)
+        {
+            BatchUnicast Delegate; Delegate.AddLambda(std::forward<Func>(InFunc));
+            return AddBatchInternal(std::move(Delegate), nullptr);
+        }
+
+        // O(1): the handle's slot leads straight to the listener, which is destroyed and marked here.
+        // Marked entries are skipped by Broadcast and erased from the arrays in bulk by Compact.
+        void Remove(FDelegateHandle InHandle)
+        {
+            if (InHandle.IsValid() && InHandle.GetSlot() == FDelegateHandle::InvalidSlot)
+            {
+                RemoveBatchIf([&](const FBatchEntry& Entry) { return Entry.Delegate.GetHandle() == InHandle; });
+                return;
+            }
+
+            const uint32_t Index = FindIndex(InHandle);
+            if (Index == InvalidIndex) return;
+
+            MarkRemovedAt(Index);
+            CompactIfNeeded();
+        }
+
+        // Proportional to the owner's own listeners: it walks the owner's list instead of every listener.
+        void RemoveAll(const void* InOwner)
+        {
+            if (!InOwner) return;
+
+            const auto Head = OwnerHeads.find(InOwner);
+            if (Head != OwnerHeads.end())
+            {
+                // Marking unlinks the listener (and drops the head with the last one), so step ahead first.
+                for (uint32_t Slot = Head->second; Slot != InvalidIndex;)
+                {
+                    const uint32_t Next = OwnerLinks[Slot].Next;
+                    MarkRemovedAt(SlotToIndex[Slot]);
+                    Slot = Next;
+                }
+            }
+
+            RemoveBatchIf([&](const FBatchEntry& Entry) { return Entry.Owner == InOwner; });
+            CompactIfNeeded();
+        }
+
+        void Broadcast(TDelegateParam<ArgsType>... Args)
+        {
+            if constexpr (bCanCopyEvents)
+            {
+                if (!BatchEntries.empty() || AwaitersHead)
+                {
+                    // Captured before the per-event listeners run, since a listener taking an rvalue may move from Args.
+                    const FEventArgs Event(Args...);
+                    {
+                        FBroadcastScope Scope(*this);
+                        BroadcastToBindings(FThunkArgs(Args...));
+                        BroadcastToBatchEntries(FEventBatch(&Event, 1));
+                    }
+                    ResumeAwaiters(Event);
+                    return;
+                }
+            }
+
+            if (Bindings.empty()) return;
+
+            FBroadcastScope Scope(*this);
+            BroadcastToBindings(FThunkArgs(Args...));
+        }
+
+        // Broadcast to the listeners added with FDelegateBindOptions::Filtered(InKey) and the unfiltered ones, in the
+        // usual order. The others are skipped by scanning the contiguous key array, without calling into them, so a
+        // broadcast addressed to one entity costs its own listeners plus a few compares per listener.
+        //
+        //   OnDamaged.AddRaw(&Turret, &FTurret::OnDamaged, FDelegateBindOptions().Filtered(Turret.EntityID));
+        //   OnDamaged.BroadcastKeyed(Target.EntityID, Damage);
+        void BroadcastKeyed(uint32_t InKey, TDelegateParam<ArgsType>... Args)
+        {
+            if constexpr (bCanCopyEvents)
+            {
+                if (!BatchEntries.empty() || AwaitersHead)
+                {
+                    // Batch listeners and coroutines take no key, so they hear every broadcast.
+                    const FEventArgs Event(Args...);
+                    {
+                        FBroadcastScope Scope(*this);
+                        BroadcastToMatchingBindings(InKey, FThunkArgs(Args...));
+                        BroadcastToBatchEntries(FEventBatch(&Event, 1));
+                    }
+                    ResumeAwaiters(Event);
+                    return;
+                }
+            }
+
+            if (Bindings.empty()) return;
+
+            FBroadcastScope Scope(*this);
+            BroadcastToMatchingBindings(InKey, FThunkArgs(Args...));
+        }
+
+        // Awaitable for the next broadcast, see TBroadcastAwaiter:
+        //
+        //   const auto [MaxHealth, Health, Delta] = co_await Player.OnHealthChanged.Next();
+        [[nodiscard]] FAwaiter Next()
+        {
+            static_assert(bCanCopyEvents, "Next() needs copyable arguments: the awaiting coroutine gets a copy of the event");
+            return FAwaiter(*this);
+        }
+
+        // Broadcast that spreads the AnyThread listeners (see FDelegateBindOptions) over InExecutor in chunks; the calling
+        // thread works on chunks as well, then calls the CallerThread listeners itself once all chunks are done, and the
+        // batch listeners last. Returns when every listener has run. Listeners on workers run concurrently and in no
+        // particular order, so they must not touch this delegate, and they share reference arguments.
+        //
+        // Priorities are kept between bands: every listener of one priority, either affinity, has run before any
+        // listener of a lower priority starts. Within a band the CallerThread listeners run after the AnyThread ones.
+        //
+        // ExecutorType needs GetNumWorkers() and ParallelFor(NumTasks, void(*)(void*, uint32_t), void*), as
+        // FWorkStealingExecutor (DelegateExecutor.h) has.
+        template <typename ExecutorType>
+        void ParallelBroadcast(ExecutorType& InExecutor, TDelegateParam<ArgsType>... Args)
+        {
+            static_assert((!std::is_rvalue_reference_v<TDelegateParam<ArgsType>> && ...), "ParallelBroadcast cannot hand one rvalue to several listeners at once");
+
+            if constexpr (bCanCopyEvents)
+            {
+                if (!BatchEntries.empty() || AwaitersHead)
+                {
+                    const FEventArgs Event(Args...);
+                    {
+                        FBroadcastScope Scope(*this);
+                        ParallelBroadcastToBindings(InExecutor, FThunkArgs(Args...));
+                        BroadcastToBatchEntries(FEventBatch(&Event, 1));
+                    }
+                    ResumeAwaiters(Event);
+                    return;
+                }
+            }
+
+            if (Bindings.empty()) return;
+
+            FBroadcastScope Scope(*this);
+            ParallelBroadcastToBindings(InExecutor, FThunkArgs(Args...));
+        }
+
+        // Folds the listeners' return values in broadcast order: Accumulator = InReducer(std::move(Accumulator), Value).
+        // A reducer with IsDone(Accumulator) stops the broadcast as soon as it returns true, so the remaining
+        // listeners are not called (see FAnyTrue, FAllTrue, FFirstNonDefault). Batch listeners return nothing and
+        // are not called.
+        //
+        //   const float Damage = OnModifyDamage.BroadcastReduce([](float Sum, float Modifier) { return Sum + Modifier; }, 0.0f, Hit);
+        template <typename ReducerType, typename AccumulatorType>
+        AccumulatorType BroadcastReduce(ReducerType&& InReducer, AccumulatorType InInit, TDelegateParam<ArgsType>... Args)
+        {
+            static_assert(!std::is_void_v<RetType>, "BroadcastReduce needs listeners that return a value");
+            static_assert(!std::is_rvalue_reference_v<RetType>, "BroadcastReduce cannot collect rvalue references");
+
+            AccumulatorType Accumulator = std::move(InInit);
+            if (IsReduceDone(InReducer, Accumulator) || Bindings.empty()) return Accumulator;
+
+            FBroadcastScope Scope(*this);
+
+#if DELEGATES_WITH_STATS
+            FDelegateBroadcastStatScope BroadcastStats(DebugName);
+#endif
+
+            const FBinding* const BindingData = Bindings.data();
+            const size_t NumBindings = Bindings.size();
+
+            const FThunkArgs ThunkArgs(Args...);
+            FResultSlot Result;
+            for (size_t Index = 0; Index < NumBindings; ++Index)
+            {
+                const FBinding& Binding = BindingData[Index];
+                if (!Binding.Thunk) continue;
+
+#if DELEGATES_WITH_STATS
+                ++BroadcastStats.NumListeners;
+#endif
+                if (!Binding.Thunk(*this, Binding, &Result, ThunkArgs))
+                {
+                    MarkRemoved(Index);
+                    continue;
+                }
+
+                if constexpr (std::is_reference_v<RetType>) Accumulator = InReducer(std::move(Accumulator), Result->get());
+                else Accumulator = InReducer(std::move(Accumulator), std::move(*Result));
+                Result.reset();
+
+                if (IsReduceDone(InReducer, Accumulator)) break;
+            }
+
+            return Accumulator;
+        }
+
+        // True if any listener returns true; stops at the first one that does.
+        bool BroadcastAnyTrue(TDelegateParam<ArgsType>... Args)
+        {
+            return BroadcastReduce(FAnyTrue(), false, std::forward<TDelegateParam<ArgsType>>(Args)...);
+        }
+
+        // True if every listener returns true (or there are none); stops at the first one that doesn't.
+        bool BroadcastAllTrue(TDelegateParam<ArgsType>... Args)
+        {
+            return BroadcastReduce(FAllTrue(), true, std::forward<TDelegateParam<ArgsType>>(Args)...);
+        }
+
+        // The first return value that differs from a value-initialized one, or that default if none does.
+        std::decay_t<RetType> BroadcastFirstNonDefault(TDelegateParam<ArgsType>... Args)
+        {
+            return BroadcastReduce(FFirstNonDefault(), std::decay_t<RetType>{}, std::forward<TDelegateParam<ArgsType>>(Args)...);
+        }
+
+        // Queues a broadcast to be dispatched by the next Flush. Taken by value, so temporaries are moved into the queue.
+        void EnqueueBroadcast(ArgsType... Args)
+        {
+            QueuedEvents.emplace_back(std::forward<ArgsType>(Args)...);
+        }
+
+        // Queues a broadcast that replaces the one an earlier EnqueueCoalesced or EnqueueMerged left pending, so each
+        // Flush dispatches at most one of them, where the first was queued. For high-frequency state signals whose
+        // listeners only need the latest value.
+        void EnqueueCoalesced(ArgsType... Args)
+        {
+            EnqueueMerged([](FEventArgs& InOutPending, FEventArgs&& InEvent) { InOutPending = std::move(InEvent); }, std::forward<ArgsType>(Args)...);
+        }
+
+        // As EnqueueCoalesced, but Merge(FEventArgs& InOutPending, FEventArgs&& InEvent) folds each new event into the
+        // pending one, e.g. to keep the latest health and sum the deltas:
+        //
+        //   OnHealthChanged.EnqueueMerged([](auto& Pending, auto&& Event)
+        //       { Pending = { std::get<0>(Event), std::get<1>(Event), std::get<2>(Pending) + std::get<2>(Event) }; },
+        //       MaxHealth, Health, InDelta);
+        template <typename MergeType>
+        void EnqueueMerged(MergeType&& Merge, ArgsType... Args)
+        {
+            if (CoalescedIndex == InvalidIndex)
+            {
+                CoalescedIndex = static_cast<uint32_t>(QueuedEvents.size());
+                QueuedEvents.emplace_back(std::forward<ArgsType>(Args)...);
+                return;
+            }
+
+            std::invoke(Merge, QueuedEvents[CoalescedIndex], FEventArgs(std::forward<ArgsType>(Args)...));
+        }
+
+        __forceinline size_t GetNumQueuedEvents() const { return QueuedEvents.size(); }
+
+        // Dispatches every queued event listener-major: each listener receives all events, in order, before the
+        // next listener runs, so its code and data stay hot. Events queued during a Flush wait for the next one.
+        void Flush()
+        {
+            if (QueuedEvents.empty() || bFlushing) return;
+
+            // The two queues are swapped rather than reallocated, so their capacity serves as a per-frame arena.
+            std::swap(QueuedEvents, FlushingEvents);
+            CoalescedIndex = InvalidIndex;
+            bFlushing = true;
+
+            {
+                FBroadcastScope Scope(*this);
+
+#if DELEGATES_WITH_STATS
+                FDelegateBroadcastStatScope BroadcastStats(DebugName);
+#endif
+
+                const size_t NumBindings = Bindings.size();
+                for (size_t Index = 0; Index < NumBindings; ++Index)
+                {
+#if DELEGATES_WITH_STATS
+                    FDelegateListenerStatScope ListenerStats(DebugName, Infos[Index].DebugName);
+                    if (Bindings[Index].Thunk) BroadcastStats.NumListeners += FlushingEvents.size();
+#endif
+                    for (FEventArgs& Event : FlushingEvents)
+                    {
+                        const FBinding& Binding = Bindings[Index];
+                        if (!Binding.Thunk) break;
+
+                        bool bExecuted;
+                        if constexpr (bPackArgsByValue) bExecuted = Binding.Thunk(*this, Binding, nullptr, Event);
+                        else bExecuted = Binding.Thunk(*this, Binding, nullptr, std::apply([](auto&... EventArgs) { return FThunkArgs(EventArgs...); }, Event));
+
+                        if (!bExecuted)
+                        {
+                            MarkRemoved(Index);
+                            break;
+                        }
+                    }
+                }
+
+                BroadcastToBatchEntries(FEventBatch(FlushingEvents));
+            }
+
+            // Each event is a broadcast of its own, so a coroutine that awaits again gets the next one.
+            if (AwaitersHead)
+            {
+                for (const FEventArgs& Event : FlushingEvents)
+                {
+                    if (!ResumeAwaiters(Event)) return;
+                }
+            }
+
+            FlushingEvents.clear();
+            bFlushing = false;
+        }
+
+        // Erases removed and dead listeners now, or once the outermost Broadcast returns if called from a listener.
+        void Compact()
+        {
+            if (IsBroadcasting())
+            {
+                bCompactRequested = true;
+                return;
+            }
+
+            CompactNow();
+        }
+
+        __forceinline void SetCompactionThreshold(float InThreshold) { CompactionThreshold = InThreshold; }
+        __forceinline size_t GetNumRemoved() const { return NumRemoved; }
+
+        // Listeners holding a handle slot: bound ones, those added mid-broadcast and removed ones not yet compacted.
+        __forceinline size_t GetNumSlotsInUse() const { return Bindings.size() + PendingAdds.size(); }
+
+        // Makes room for InNumListeners, so adding up to that many listeners does not reallocate the listener arrays.
+        void Reserve(size_t InNumListeners)
+        {
+            Bindings.reserve(InNumListeners);
+            Infos.reserve(InNumListeners);
+            FilterKeys.reserve(InNumListeners);
+            SlotToIndex.reserve(InNumListeners);
+            OwnerLinks.reserve(InNumListeners);
+            OwnerHeads.reserve(InNumListeners);
+        }
+
+        // Bytes held by the delegate: itself, the capacity of every listener array and event queue, listener instances
+        // that did not fit inline and the owner index (estimated from its buckets and entries). Memory owned by bound
+        // callables or queued arguments is not counted.
+        size_t GetMemoryFootprint() const
+        {
+            size_t Bytes = sizeof(*this);
+
+            Bytes += GetCapacityBytes(Bindings) + GetCapacityBytes(Infos) + GetCapacityBytes(FilterKeys) + GetCapacityBytes(PendingAdds);
+            Bytes += GetCapacityBytes(GenericDelegates) + GetCapacityBytes(FreeGenericSlots) + GetCapacityBytes(DeferredGenericReleases);
+            Bytes += GetCapacityBytes(SlotToIndex) + GetCapacityBytes(FreeSlots) + GetCapacityBytes(OwnerLinks);
+            Bytes += GetCapacityBytes(BatchEntries) + GetCapacityBytes(PinnedObjects) + GetCapacityBytes(ParallelDeadFlags);
+            Bytes += GetCapacityBytes(QueuedEvents) + GetCapacityBytes(FlushingEvents);
+
+            for (const Unicast& Delegate : GenericDelegates) Bytes += Delegate.GetMemoryFootprint() - sizeof(Unicast);
+            for (const FPendingAdd& Pending : PendingAdds) Bytes += Pending.Delegate.GetMemoryFootprint() - sizeof(Unicast);
+            for (const auto& Entry : BatchEntries) Bytes += sizeof(FBatchEntry) + Entry->Delegate.GetMemoryFootprint() - sizeof(BatchUnicast);
+
+            // One pointer per bucket; a node holds the entry and, depending on the library, up to two links.
+            Bytes += OwnerHeads.bucket_count() * sizeof(void*) + OwnerHeads.size() * (sizeof(typename FOwnerHeadMap::value_type) + 2 * sizeof(void*));
+
+            return Bytes;
+        }
+
+        // Compacts, then gives back whatever the remaining listeners don't need: spare array capacity, slots past the
+        // last one in use, spare owner index buckets and the event queues' capacity. Meant for idle delegates, e.g. a
+        // pooled actor's when it goes back to the pool. Called during a broadcast or flush, it only requests the
+        // compaction.
+        void ShrinkToFit()
+        {
+            if (IsBroadcasting() || bFlushing)
+            {
+                bCompactRequested = true;
+                return;
+            }
+
+            CompactNow();
+            if (!BatchEntries.empty()) CompactBatchEntries();
+
+            // Compaction released every listener that can't run, so the unbound delegates left are free slots.
+            while (!GenericDelegates.empty() && !GenericDelegates.back().IsBound()) GenericDelegates.pop_back();
+            std::erase_if(FreeGenericSlots, [this](uint32_t InIndex) { return InIndex >= GenericDelegates.size(); });
+
+            // Handles to trimmed slots are stale, and FindIndex rejects slots past the end.
+            while (!SlotToIndex.empty() && SlotToIndex.back() == InvalidIndex)
+            {
+                SlotToIndex.pop_back();
+                OwnerLinks.pop_back();
+            }
+            std::erase_if(FreeSlots, [this](uint32_t InSlot) { return InSlot >= SlotToIndex.size(); });
+
+            Bindings.shrink_to_fit();
+            Infos.shrink_to_fit();
+            FilterKeys.shrink_to_fit();
+            PendingAdds.shrink_to_fit();
+            GenericDelegates.shrink_to_fit();
+            FreeGenericSlots.shrink_to_fit();
+            DeferredGenericReleases.shrink_to_fit();
+            SlotToIndex.shrink_to_fit();
+            FreeSlots.shrink_to_fit();
+            OwnerLinks.shrink_to_fit();
+            BatchEntries.shrink_to_fit();
+            PinnedObjects.shrink_to_fit();
+            ParallelDeadFlags.clear();
+            ParallelDeadFlags.shrink_to_fit();
+            QueuedEvents.shrink_to_fit();
+            FlushingEvents.shrink_to_fit();
+
+            OwnerHeads.rehash(0);
+        }
+
+    private:
+        // ===== Thunks =====
+
+        // Bindings are copied bytewise when the arrays move, so only trivially copyable lambdas live there.
+        // Nullable callables are left to TDelegate, which checks them before each call.
+        template <typename FuncType>
+        static constexpr bool CanStoreInBinding =
+            std::is_trivially_copyable_v<FuncType> && std::is_trivially_destructible_v<FuncType> &&
+            sizeof(FuncType) <= sizeof(FBinding::Target) && alignof(FuncType) <= alignof(void*) &&
+            !std::is_constructible_v<bool, const FuncType&>;
+
+        // Unpacks InArgs into InCall's parameters, restoring how each was declared (copies, const references, rvalues).
+        template <typename CallType>
+        static __forceinline decltype(auto) Apply(const FThunkArgs& InArgs, CallType&& InCall)
+        {
+            return std::apply([&](auto&... Args) -> decltype(auto) { return InCall(static_cast<TDelegateParam<ArgsType>>(Args)...); }, InArgs);
+        }
+
+        // Keeps the return value only when BroadcastReduce asks for it.
+        template <typename CallType>
+        static __forceinline void Invoke(FResultSlot* OutResult, const FThunkArgs& InArgs, CallType&& InCall)
+        {
+            if constexpr (!std::is_void_v<RetType>)
+            {
+                if (OutResult)
+                {
+                    OutResult->emplace(Apply(InArgs, InCall));
+                    return;
+                }
+            }
+            Apply(InArgs, InCall);
+        }
+
+        static bool CallStatic(TMulticastDelegate&, const FBinding& InBinding, FResultSlot* OutResult, const FThunkArgs& InArgs)
+        {
+            TFuncPtr<RetType(ArgsType...)> Fn;
+            std::memcpy(&Fn, InBinding.Target, sizeof(Fn));
+            if (Fn == nullptr) return false;
+
+            Invoke(OutResult, InArgs, [&](TDelegateParam<ArgsType>... Args) -> RetType { return Fn(std::forward<TDelegateParam<ArgsType>>(Args)...); });
+            return true;
+        }
+
+        template <typename Class>
+        static bool CallRaw(TMulticastDelegate&, const FBinding& InBinding, FResultSlot* OutResult, const FThunkArgs& InArgs)
+        {
+            TMemFuncPtr<Class, RetType(ArgsType...)> Method;
+            std::memcpy(&Method, InBinding.Target, sizeof(Method));
+            if (InBinding.Object == nullptr || Method == nullptr) return false;
+
+            Class* Object = static_cast<Class*>(InBinding.Object);
+            Invoke(OutResult, InArgs, [&](TDelegateParam<ArgsType>... Args) -> RetType { return (Object->*Method)(std::forward<TDelegateParam<ArgsType>>(Args)...); });
+            return true;
+        }
+
+        template <typename FuncType>
+        static bool CallLambda(TMulticastDelegate&, const FBinding& InBinding, FResultSlot* OutResult, const FThunkArgs& InArgs)
+        {
+            FuncType& Fn = *std::launder(reinterpret_cast<FuncType*>(const_cast<unsigned char*>(InBinding.Target)));
+            Invoke(OutResult, InArgs, [&](TDelegateParam<ArgsType>... Args) -> RetType { return Fn(std::forward<TDelegateParam<ArgsType>>(Args)...); });
+            return true;
+        }
+
+        template <auto Function>
+        static bool CallStaticFunction(TMulticastDelegate&, const FBinding&, FResultSlot* OutResult, const FThunkArgs& InArgs)
+        {
+            Invoke(OutResult, InArgs, [](TDelegateParam<ArgsType>... Args) -> RetType { return Function(std::forward<TDelegateParam<ArgsType>>(Args)...); });
+            return true;
+        }
+
+        template <auto Method, typename Class>
+        static bool CallRawMethod(TMulticastDelegate&, const FBinding& InBinding, FResultSlot* OutResult, const FThunkArgs& InArgs)
+        {
+            if (InBinding.Object == nullptr) return false;
+
+            Class* Object = static_cast<Class*>(InBinding.Object);
+            Invoke(OutResult, InArgs, [&](TDelegateParam<ArgsType>... Args) -> RetType { return (Object->*Method)(std::forward<TDelegateParam<ArgsType>>(Args)...); });
+            return true;
+        }
+
+        static bool CallGeneric(TMulticastDelegate& InSelf, const FBinding& InBinding, FResultSlot* OutResult, const FThunkArgs& InArgs)
+        {
+            uint32_t GenericIndex;
+            std::memcpy(&GenericIndex, InBinding.Target, sizeof(GenericIndex));
+
+            const Unicast& Delegate = InSelf.GenericDelegates[GenericIndex];
+            if (GenericIndex < InSelf.PinnedObjects.size() && InSelf.PinnedObjects[GenericIndex])
+            {
+                const void* Pinned = InSelf.PinnedObjects[GenericIndex].get();
+                Invoke(OutResult, InArgs, [&](TDelegateParam<ArgsType>... Args) -> RetType { return Delegate.ExecutePinned(Pinned, std::forward<TDelegateParam<ArgsType>>(Args)...); });
+                return true;
+            }
+
+            if (!OutResult) return Apply(InArgs, [&](TDelegateParam<ArgsType>... Args) { return Delegate.TryExecute(std::forward<TDelegateParam<ArgsType>>(Args)...); });
+
+            // TryExecute drops the result, so weak listeners are pinned for the call instead.
+            if (const std::shared_ptr<const void> Pin = Delegate.PinObject())
+            {
+                Invoke(OutResult, InArgs, [&](TDelegateParam<ArgsType>... Args) -> RetType { return Delegate.ExecutePinned(Pin.get(), std::forward<TDelegateParam<ArgsType>>(Args)...); });
+                return true;
+            }
+            if (!Delegate.IsBound()) return false;
+
+            Invoke(OutResult, InArgs, [&](TDelegateParam<ArgsType>... Args) -> RetType { return Delegate.Execute(std::forward<TDelegateParam<ArgsType>>(Args)...); });
+            return true;
+        }
+
+        // ===== Broadcast =====
+
+        // Chunks are sized for a few per thread, so workers that finish early can steal from the others.
+        static constexpr size_t MinParallelChunkSize = 64;
+        static constexpr size_t ParallelChunksPerThread = 4;
+
+        struct FParallelContext
+        {
+            TMulticastDelegate& Self;
+            size_t BandBegin;
+            size_t BandEnd;
+            size_t ChunkSize;
+            const FThunkArgs& Args;
+        };
+
+        // Runs on workers: calls the AnyThread listeners of one chunk of the band and only flags the dead ones.
+        static void RunParallelChunk(void* InContext, uint32_t InChunkIndex)
+        {
+            FParallelContext& Context = *static_cast<FParallelContext*>(InContext);
+            TMulticastDelegate& Self = Context.Self;
+
+            const size_t Begin = Context.BandBegin + static_cast<size_t>(InChunkIndex) * Context.ChunkSize;
+            const size_t End = std::min(Begin + Context.ChunkSize, Context.BandEnd);
+
+            for (size_t Index = Begin; Index < End; ++Index)
+            {
+                const FBinding& Binding = Self.Bindings[Index];
+                if (!Binding.Thunk || Self.Infos[Index].Affinity != EDelegateAffinity::AnyThread) continue;
+
+                if (!Binding.Thunk(Self, Binding, nullptr, Context.Args)) Self.ParallelDeadFlags[Index] = 1;
+            }
+        }
+
+        template <typename ExecutorType>
+        void ParallelBroadcastToBindings(ExecutorType& InExecutor, const FThunkArgs& InArgs)
+        {
+            const size_t NumBindings = Bindings.size();
+            if (NumBindings == 0) return;
+
+#if DELEGATES_WITH_STATS
+            // Per-listener stats are only recorded on the calling thread; workers count towards the broadcast.
+            FDelegateBroadcastStatScope BroadcastStats(DebugName);
+#endif
+
+            const size_t NumThreads = static_cast<size_t>(InExecutor.GetNumWorkers()) + 1;
+
+            // The flags are all clear between uses, so a nested ParallelBroadcast from a CallerThread listener can share
+            // them. The arrays don't grow during a broadcast, so neither does this.
+            if (ParallelDeadFlags.size() < NumBindings) ParallelDeadFlags.resize(NumBindings, 0);
+
+            // Listeners are sorted by priority, so each priority is one contiguous band; a band finishes before the
+            // next one starts.
+            for (size_t BandBegin = 0; BandBegin < NumBindings;)
+            {
+                const int32_t Priority = Infos[BandBegin].Priority;
+                const size_t BandEnd = static_cast<size_t>(std::partition_point(Infos.begin() + BandBegin, Infos.begin() + NumBindings,
+                    [Priority](const FBindingInfo& InInfo) { return InInfo.Priority == Priority; }) - Infos.begin());
+
+                const size_t BandSize = BandEnd - BandBegin;
+                const size_t ChunkSize = std::max(MinParallelChunkSize, BandSize / (NumThreads * ParallelChunksPerThread));
+                const uint32_t NumChunks = static_cast<uint32_t>((BandSize + ChunkSize - 1) / ChunkSize);
+
+                FParallelContext Context{ *this, BandBegin, BandEnd, ChunkSize, InArgs };
+
+#if DELEGATES_WITH_STATS
+                // Workers can't share the counter, so the AnyThread listeners they are about to call are counted here.
+                for (size_t Index = BandBegin; Index < BandEnd; ++Index)
+                {
+                    if (Bindings[Index].Thunk && Infos[Index].Affinity == EDelegateAffinity::AnyThread) ++BroadcastStats.NumListeners;
+                }
+#endif
+
+                if (NumChunks > 1 && NumThreads > 1) InExecutor.ParallelFor(NumChunks, &RunParallelChunk, &Context);
+                else for (uint32_t Chunk = 0; Chunk < NumChunks; ++Chunk) RunParallelChunk(&Context, Chunk);
+
+                // Back on the calling thread alone: mark what the workers found dead, then run the band's CallerThread
+                // listeners in order. These may add and remove listeners like in Broadcast.
+                for (size_t Index = BandBegin; Index < BandEnd; ++Index)
+                {
+                    if (ParallelDeadFlags[Index])
+                    {
+                        ParallelDeadFlags[Index] = 0;
+                        MarkRemoved(Index);
+                        continue;
+                    }
+
+                    const FBinding& Binding = Bindings[Index];
+                    if (!Binding.Thunk || Infos[Index].Affinity != EDelegateAffinity::CallerThread) continue;
+
+#if DELEGATES_WITH_STATS
+                    FDelegateListenerStatScope ListenerStats(DebugName, Infos[Index].DebugName);
+                    ++BroadcastStats.NumListeners;
+#endif
+                    if (!Binding.Thunk(*this, Binding, nullptr, InArgs)) MarkRemoved(Index);
+                }
+
+                BandBegin = BandEnd;
+            }
+        }
+
+        template <typename T>
+        static __forceinline size_t GetCapacityBytes(const TArray<T>& InArray) { return InArray.capacity() * sizeof(T); }
+
+        template <typename ReducerType, typename AccumulatorType>
+        static __forceinline bool IsReduceDone(const ReducerType& InReducer, const AccumulatorType& InAccumulator)
+        {
+            if constexpr (requires { { InReducer.IsDone(InAccumulator) } -> std::convertible_to<bool>; }) return InReducer.IsDone(InAccumulator);
+            else return false;
+        }
+
+        void BroadcastToBindings(const FThunkArgs& InArgs)
+        {
+            // The arrays cannot be resized while broadcasting, so the pointer stays valid across listener calls.
+            const FBinding* const BindingData = Bindings.data();
+            const size_t NumBindings = Bindings.size();
+
+#if DELEGATES_WITH_STATS
+            FDelegateBroadcastStatScope BroadcastStats(DebugName);
+#endif
+
+            for (size_t Index = 0; Index < NumBindings; ++Index)
+            {
+                const FBinding& Binding = BindingData[Index];
+                if (!Binding.Thunk) continue;
+
+#if DELEGATES_WITH_STATS
+                FDelegateListenerStatScope ListenerStats(DebugName, Infos[Index].DebugName);
+                ++BroadcastStats.NumListeners;
+#endif
+
+                // Bindings found dead here (e.g. expired weak objects) are only marked; see CompactIfNeeded.
+                if (!Binding.Thunk(*this, Binding, nullptr, InArgs)) MarkRemoved(Index);
+            }
+        }
+
+        void BroadcastToMatchingBindings(uint32_t InKey, const FThunkArgs& InArgs)
+        {
+            const FBinding* const BindingData = Bindings.data();
+            const uint32_t* const KeyData = FilterKeys.data();
+            const size_t NumBindings = Bindings.size();
+
+#if DELEGATES_WITH_STATS
+            FDelegateBroadcastStatScope BroadcastStats(DebugName);
+#endif
+
+            const auto CallAt = [&](size_t InIndex)
+                {
+                    const FBinding& Binding = BindingData[InIndex];
+                    if (!Binding.Thunk) return;
+
+#if DELEGATES_WITH_STATS
+                    FDelegateListenerStatScope ListenerStats(DebugName, Infos[InIndex].DebugName);
+                    ++BroadcastStats.NumListeners;
+#endif
+
+                    if (!Binding.Thunk(*this, Binding, nullptr, InArgs)) MarkRemoved(InIndex);
+                };
+
+            size_t Index = 0;
+
+#if DELEGATES_WITH_SSE2
+            // Four keys at a time; each set bit of the mask is a listener to call, lowest index first.
+            const __m128i Key = _mm_set1_epi32(static_cast<int>(InKey));
+            const __m128i NoKey = _mm_set1_epi32(static_cast<int>(FDelegateBindOptions::NoFilterKey));
+
+            for (; Index + 4 <= NumBindings; Index += 4)
+            {
+                const __m128i Keys = _mm_loadu_si128(reinterpret_cast<const __m128i*>(KeyData + Index));
+                const __m128i Matches = _mm_or_si128(_mm_cmpeq_epi32(Keys, Key), _mm_cmpeq_epi32(Keys, NoKey));
+
+                for (uint32_t Mask = static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(Matches))); Mask != 0; Mask &= Mask - 1)
+                {
+                    CallAt(Index + static_cast<size_t>(std::countr_zero(Mask)));
+                }
+            }
+#endif
+
+            for (; Index < NumBindings; ++Index)
+            {
+                if (KeyData[Index] == InKey || KeyData[Index] == FDelegateBindOptions::NoFilterKey) CallAt(Index);
+            }
+        }
+
+        // Resumes the coroutines that were already waiting when this broadcast started, oldest first. One that awaits
+        // Next() again while resumed has a later generation and waits for the following broadcast. A broadcast made by a
+        // resumed coroutine resumes the remaining earlier waiters with its own arguments.
+        // Returns false if a resumed coroutine destroyed the delegate; the caller must not touch it then.
+        bool ResumeAwaiters(const FEventArgs& InEvent)
+        {
+            FResumeScope Scope(*this);
+
+            const uint64_t Generation = AwaitGeneration++;
+            while (AwaitersHead && AwaitersHead->Generation <= Generation)
+            {
+                FAwaiter& Awaiter = *AwaitersHead;
+                Awaiter.Unlink();
+                Awaiter.Event = &InEvent;
+                Awaiter.Coroutine.resume();
+
+                if (Scope.bDelegateDestroyed) return false;
+            }
+
+            return true;
+        }
+
+        void BroadcastToBatchEntries(FEventBatch InEvents)
+        {
+            const size_t NumBatchEntries = BatchEntries.size();
+            for (size_t Index = 0; Index < NumBatchEntries; ++Index)
+            {
+                FBatchEntry& Entry = *BatchEntries[Index];
+                if (Entry.bRemoved) continue;
+
+                if (!Entry.Delegate.IsBound())
+                {
+                    Entry.bRemoved = true;
+                    continue;
+                }
+
+                Entry.Delegate.Execute(InEvents);
+            }
+        }
+
+        void BeginPin()
+        {
+            if (PinDepth++ > 0) return;
+
+            // The arrays cannot move while the pin is held, so pinned objects are addressed by generic index.
+            ++BroadcastDepth;
+
+            PinnedObjects.resize(GenericDelegates.size());
+            for (size_t Index = 0; Index < GenericDelegates.size(); ++Index)
+            {
+                PinnedObjects[Index] = GenericDelegates[Index].PinObject();
+            }
+        }
+
+        void EndPin()
+        {
+            assert(PinDepth > 0);
+            if (--PinDepth > 0) return;
+
+            PinnedObjects.clear();
+            if (--BroadcastDepth == 0) ApplyPending();
+        }
+
+        // ===== Batch Listeners =====
+
+        FDelegateHandle AddBatchInternal(BatchUnicast&& InDelegate, const void* InOwner)
+        {
+            static_assert(bCanCopyEvents, "Batch listeners need copyable arguments: Broadcast hands them a copy of the event");
+
+            auto Entry = std::make_unique<FBatchEntry>();
+            Entry->Delegate = std::move(InDelegate);
+            Entry->Owner = InOwner;
+
+            BatchEntries.emplace_back(std::move(Entry));
+            return BatchEntries.back()->Delegate.GetHandle();
+        }
+
+        template <typename Predicate>
+        void RemoveBatchIf(Predicate&& InPredicate)
+        {
+            for (auto& Entry : BatchEntries)
+            {
+                if (InPredicate(*Entry)) Entry->bRemoved = true;
+            }
+
+            if (!IsBroadcasting()) CompactBatchEntries();
+        }
+
+        void CompactBatchEntries()
+        {
+            BatchEntries.erase(
+                std::remove_if(BatchEntries.begin(), BatchEntries.end(),
+                    [](const std::unique_ptr<FBatchEntry>& Entry){ return Entry->bRemoved || !Entry->Delegate.IsBound(); }),
+                BatchEntries.end());
+        }
+
+        // ===== Storage =====
+
+        FDelegateHandle AddGeneric(Unicast&& InDelegate, const void* InOwner, const FDelegateBindOptions& InOptions)
+        {
+            FBinding Binding;
+            Binding.Thunk = &CallGeneric;
+            return AddInternal(Binding, FDelegateHandle(FDelegateHandle::GenerateNewHandle), InOwner, InOptions, std::move(InDelegate));
+        }
+
+        FDelegateHandle AddInternal(const FBinding& InBinding, FDelegateHandle InHandle, const void* InOwner, const FDelegateBindOptions& InOptions, Unicast&& InDelegate = Unicast())
+        {
+            FBindingInfo Info;
+            Info.Owner = InOwner;
+            Info.Priority = InOptions.Priority;
+            Info.FilterKey = InOptions.FilterKey;
+            Info.Affinity = InOptions.Affinity;
+#if DELEGATES_WITH_STATS
+            Info.DebugName = InOptions.DebugName;
+#endif
+
+            // Pending adds are addressed as if already appended, since the arrays cannot change size mid-broadcast.
+            const uint32_t Index = static_cast<uint32_t>(Bindings.size() + PendingAdds.size());
+            Info.Handle = InHandle.WithSlot(AllocateSlot(Index));
+            LinkOwner(Info);
+
+            if (IsBroadcasting())
+            {
+                PendingAdds.push_back({ InBinding, Info, std::move(InDelegate) });
+                return Info.Handle;
+            }
+
+            InsertBinding(InBinding, Info, std::move(InDelegate));
+            return Info.Handle;
+        }
+
+        // Stable insert after every listener of the same or higher priority. With equal priorities (the common case)
+        // this is an append; otherwise the listeners after it move up one and their slots are patched.
+        void InsertBinding(FBinding InBinding, FBindingInfo InInfo, Unicast&& InDelegate)
+        {
+#if DELEGATES_WITH_STATS
+            if (FDelegateStats::IsEnabled())
+            {
+                if (Bindings.size() == Bindings.capacity()) FDelegateStats::RecordAllocation(DebugName);
+                if (InDelegate.IsBound() && !InDelegate.IsStoredInline()) FDelegateStats::RecordAllocation(DebugName);
+            }
+#endif
+
+            if (InBinding.Thunk == &CallGeneric)
+            {
+                InInfo.GenericIndex = AllocateGenericSlot(std::move(InDelegate));
+                std::memcpy(InBinding.Target, &InInfo.GenericIndex, sizeof(InInfo.GenericIndex));
+            }
+
+            if (Infos.empty() || Infos.back().Priority >= InInfo.Priority)
+            {
+                SlotToIndex[InInfo.Handle.GetSlot()] = static_cast<uint32_t>(Bindings.size());
+                Bindings.push_back(InBinding);
+                Infos.push_back(InInfo);
+                FilterKeys.push_back(InInfo.FilterKey);
+                return;
+            }
+
+            const auto Position = std::upper_bound(Infos.begin(), Infos.end(), InInfo.Priority,
+                [](int32_t InPriority, const FBindingInfo& InOther) { return InPriority > InOther.Priority; });
+            const size_t Index = static_cast<size_t>(Position - Infos.begin());
+
+            Bindings.insert(Bindings.begin() + Index, InBinding);
+            Infos.insert(Position, InInfo);
+            FilterKeys.insert(FilterKeys.begin() + Index, InInfo.FilterKey);
+
+            for (size_t Moved = Index; Moved < Infos.size(); ++Moved)
+            {
+                SlotToIndex[Infos[Moved].Handle.GetSlot()] = static_cast<uint32_t>(Moved);
+            }
+        }
+
+        // Returns the listener's position (past Bindings.size() for pending adds), or InvalidIndex.
+        uint32_t FindIndex(FDelegateHandle InHandle) const
+        {
+            const uint32_t Slot = InHandle.GetSlot();
+            if (Slot >= SlotToIndex.size()) return InvalidIndex;
+
+            const uint32_t Index = SlotToIndex[Slot];
+            const FBindingInfo* Info = nullptr;
+
+            if (Index < Infos.size()) Info = &Infos[Index];
+            else if (Index != InvalidIndex && Index - Infos.size() < PendingAdds.size()) Info = &PendingAdds[Index - Infos.size()].Info;
+
+            // A reused slot holds a different binding, whose ID won't match a stale handle.
+            if (!Info || Info->bRemoved || Info->Handle != InHandle) return InvalidIndex;
+            return Index;
+        }
+
+        uint32_t AllocateSlot(uint32_t InIndex)
+        {
+            if (!FreeSlots.empty())
+            {
+                const uint32_t Slot = FreeSlots.back();
+                FreeSlots.pop_back();
+                SlotToIndex[Slot] = InIndex;
+                return Slot;
+            }
+
+            SlotToIndex.push_back(InIndex);
+            OwnerLinks.emplace_back();
+            return static_cast<uint32_t>(SlotToIndex.size() - 1);
+        }
+
+        void ReleaseSlot(const FBindingInfo& InInfo)
+        {
+            SlotToIndex[InInfo.Handle.GetSlot()] = InvalidIndex;
+            FreeSlots.push_back(InInfo.Handle.GetSlot());
+        }
+
+        // Pushes the listener at the front of its owner's list.
+        void LinkOwner(const FBindingInfo& InInfo)
+        {
+            if (!InInfo.Owner) return;
+
+            const uint32_t Slot = InInfo.Handle.GetSlot();
+            OwnerLinks[Slot] = FOwnerLink();
+
+            const auto [Head, bInserted] = OwnerHeads.try_emplace(InInfo.Owner, Slot);
+            if (bInserted) return;
+
+            OwnerLinks[Slot].Next = Head->second;
+            OwnerLinks[Head->second].Prev = Slot;
+            Head->second = Slot;
+        }
+
+        // Called once per listener, when it is marked removed or found dead by compaction.
+        void UnlinkOwner(const FBindingInfo& InInfo)
+        {
+            if (!InInfo.Owner) return;
+
+            const uint32_t Slot = InInfo.Handle.GetSlot();
+            const FOwnerLink Link = OwnerLinks[Slot];
+
+            if (Link.Next != InvalidIndex) OwnerLinks[Link.Next].Prev = Link.Prev;
+
+            if (Link.Prev != InvalidIndex)
+            {
+                OwnerLinks[Link.Prev].Next = Link.Next;
+            }
+            else if (Link.Next != InvalidIndex)
+            {
+                OwnerHeads.find(InInfo.Owner)->second = Link.Next;
+            }
+            else
+            {
+                OwnerHeads.erase(InInfo.Owner);
+            }
+
+            OwnerLinks[Slot] = FOwnerLink();
+        }
+
+        uint32_t AllocateGenericSlot(Unicast&& InDelegate)
+        {
+            if (!FreeGenericSlots.empty())
+            {
+                const uint32_t GenericIndex = FreeGenericSlots.back();
+                FreeGenericSlots.pop_back();
+                GenericDelegates[GenericIndex] = std::move(InDelegate);
+                return GenericIndex;
+            }
+
+            GenericDelegates.push_back(std::move(InDelegate));
+            return static_cast<uint32_t>(GenericDelegates.size() - 1);
+        }
+
+        void ReleaseGenericSlot(uint32_t InGenericIndex)
+        {
+            if (InGenericIndex == InvalidIndex) return;
+
+            GenericDelegates[InGenericIndex].Unbind();
+            FreeGenericSlots.push_back(InGenericIndex);
+        }
+
+        // Only the array entry waits for compaction: the listener's instance (its captures, a weak object's control
+        // block) is destroyed here, or once the outermost broadcast returns if it is removed mid-broadcast, since it
+        // may be the listener running.
+        void MarkRemoved(size_t InIndex)
+        {
+            FBindingInfo& Info = Infos[InIndex];
+            if (Info.bRemoved) return;
+
+            Info.bRemoved = true;
+            Bindings[InIndex].Thunk = nullptr;
+            UnlinkOwner(Info);
+            ++NumRemoved;
+
+            if (Info.GenericIndex == InvalidIndex) return;
+
+            if (IsBroadcasting()) DeferredGenericReleases.push_back(Info.GenericIndex);
+            else ReleaseGenericSlot(Info.GenericIndex);
+            Info.GenericIndex = InvalidIndex;
+        }
+
+        // A pending listener has not run yet, so it is destroyed right away.
+        void MarkRemoved(FPendingAdd& InPending)
+        {
+            if (InPending.Info.bRemoved) return;
+
+            InPending.Info.bRemoved = true;
+            InPending.Binding.Thunk = nullptr;
+            InPending.Delegate.Unbind();
+            UnlinkOwner(InPending.Info);
+            ++NumRemoved;
+        }
+
+        // InIndex as returned by FindIndex: past Bindings.size() it addresses a pending add.
+        void MarkRemovedAt(uint32_t InIndex)
+        {
+            if (InIndex < Bindings.size()) MarkRemoved(InIndex);
+            else MarkRemoved(PendingAdds[InIndex - Bindings.size()]);
+        }
+
+        // Removed listeners are already destroyed (see MarkRemoved); the threshold only decides when their array entries
+        // are erased.
+        void CompactIfNeeded()
+        {
+            if (IsBroadcasting() || NumRemoved == 0) return;
+
+            if (bCompactRequested || static_cast<float>(NumRemoved) > static_cast<float>(Bindings.size()) * CompactionThreshold) CompactNow();
+        }
+
+        // Stable erase of removed and no longer bound listeners; patches the slot of every listener that moves.
+        void CompactNow()
+        {
+            assert(!IsBroadcasting());
+            bCompactRequested = false;
+
+#if DELEGATES_WITH_STATS
+            if (FDelegateStats::IsEnabled()) FDelegateStats::RecordCompaction(DebugName);
+#endif
+
+            size_t WriteIndex = 0;
+            for (size_t ReadIndex = 0; ReadIndex < Infos.size(); ++ReadIndex)
+            {
+                const FBindingInfo& Info = Infos[ReadIndex];
+                if (Info.bRemoved || (Info.GenericIndex != InvalidIndex && !GenericDelegates[Info.GenericIndex].IsBound()))
+                {
+                    if (!Info.bRemoved) UnlinkOwner(Info);
+                    ReleaseSlot(Info);
+                    ReleaseGenericSlot(Info.GenericIndex);
+                    continue;
+                }
+
+                if (WriteIndex != ReadIndex)
+                {
+                    Bindings[WriteIndex] = Bindings[ReadIndex];
+                    Infos[WriteIndex] = Info;
+                    FilterKeys[WriteIndex] = FilterKeys[ReadIndex];
+                }
+                SlotToIndex[Infos[WriteIndex].Handle.GetSlot()] = static_cast<uint32_t>(WriteIndex);
+                ++WriteIndex;
+            }
+
+            Bindings.resize(WriteIndex);
+            Infos.resize(WriteIndex);
+            FilterKeys.resize(WriteIndex);
+            NumRemoved = 0;
+        }
+
+        void ApplyPending()
+        {
+            if (!BatchEntries.empty()) CompactBatchEntries();
+
+            for (uint32_t GenericIndex : DeferredGenericReleases) ReleaseGenericSlot(GenericIndex);
+            DeferredGenericReleases.clear();
+
+            for (FPendingAdd& Pending : PendingAdds)
+            {
+                if (!Pending.Info.bRemoved) continue;
+
+                ReleaseSlot(Pending.Info);
+                --NumRemoved;
+            }
+
+            CompactIfNeeded();
+
+            if (PendingAdds.empty()) return;
+
+            for (FPendingAdd& Pending : PendingAdds)
+            {
+                if (Pending.Info.bRemoved) continue;
+
+                InsertBinding(Pending.Binding, Pending.Info, std::move(Pending.Delegate));
+            }
+            PendingAdds.clear();
+        }
+
+    private:
+        // Parallel arrays, indexed alike; Broadcast only streams through Bindings, BroadcastKeyed through FilterKeys first.
+        TArray<FBinding> Bindings;
+        TArray<FBindingInfo> Infos;
+        TArray<uint32_t> FilterKeys;
+        TArray<FPendingAdd> PendingAdds;
+
+        // Stable storage for listeners that are not called straight from Bindings; slots are reused.
+        TArray<Unicast> GenericDelegates;
+        TArray<uint32_t> FreeGenericSlots;
+        // Generic listeners removed mid-broadcast, destroyed once the outermost broadcast returns.
+        TArray<uint32_t> DeferredGenericReleases;
+
+        // Slot map: a handle's slot indexes SlotToIndex, which holds the listener's position in Bindings.
+        TArray<uint32_t> SlotToIndex;
+        TArray<uint32_t> FreeSlots;
+
+        // Owner index for RemoveAll: OwnerHeads maps an owner to the slot heading its list, OwnerLinks is per slot.
+        TArray<FOwnerLink> OwnerLinks;
+        FOwnerHeadMap OwnerHeads;
+
+        TArray<std::unique_ptr<FBatchEntry>> BatchEntries;
+
+        // Filled by FWeakPinScope, indexed like GenericDelegates; null for delegates that hold no weak object.
+        TArray<std::shared_ptr<const void>> PinnedObjects;
+        uint32_t PinDepth = 0;
+
+        // ParallelBroadcast's per-listener flags for the AnyThread listeners workers found dead; kept between calls.
+        TArray<uint8_t> ParallelDeadFlags;
+
+        TArray<FEventArgs> QueuedEvents;
+        TArray<FEventArgs> FlushingEvents;
+        // Position in QueuedEvents of the event EnqueueCoalesced and EnqueueMerged fold into.
+        uint32_t CoalescedIndex = InvalidIndex;
+
+        uint32_t BroadcastDepth = 0;
+        float CompactionThreshold = DefaultCompactionThreshold;
+        size_t NumRemoved = 0;
+        bool bCompactRequested = false;
+        bool bFlushing = false;
+
+        friend FScopedHandle;
+        FScopedHandle* ScopedHandles = nullptr;
+
+        friend FAwaiter;
+        FAwaiter* AwaitersHead = nullptr;
+        FAwaiter* AwaitersTail = nullptr;
+        uint64_t AwaitGeneration = 0;
+
+        // Liveness token of each ResumeAwaiters on the stack, innermost first; set by the destructor.
+        struct FResumeScope
+        {
+            explicit FResumeScope(TMulticastDelegate& InOwner) : Owner(InOwner), Outer(InOwner.ResumeScopes) { Owner.ResumeScopes = this; }
+            ~FResumeScope() { if (!bDelegateDestroyed) Owner.ResumeScopes = Outer; }
+
+            FResumeScope(const FResumeScope&) = delete;
+            FResumeScope& operator=(const FResumeScope&) = delete;
+
+            TMulticastDelegate& Owner;
+            FResumeScope* const Outer;
+            bool bDelegateDestroyed = false;
+        };
+        FResumeScope* ResumeScopes = nullptr;
+
+        const char* DebugName = nullptr;
     };
 }
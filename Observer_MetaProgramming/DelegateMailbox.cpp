@@ -0,0 +1,100 @@
+#include "DelegateMailbox.h"
+
+#include <assert.h>
+#include <bit>
+
+namespace Delegates
+{
+    FDelegateMailbox::FDelegateMailbox(std::size_t InCapacity)
+        : OwnerThread(std::this_thread::get_id())
+    {
+        const std::size_t Capacity = std::bit_ceil(InCapacity < 2 ? std::size_t(2) : InCapacity);
+        Cells = std::make_unique<FCell[]>(Capacity);
+        Mask = Capacity - 1;
+
+        for (std::size_t Index = 0; Index < Capacity; ++Index) Cells[Index].Sequence.store(Index, std::memory_order_relaxed);
+    }
+
+    FDelegateMailbox::~FDelegateMailbox()
+    {
+        for (;; ++PumpPosition)
+        {
+            FCell& Cell = Cells[PumpPosition & Mask];
+            if (Cell.Sequence.load(std::memory_order_acquire) != PumpPosition + 1) break;
+
+            Cell.Run(Cell.Message, false);
+        }
+    }
+
+    FDelegateMailbox::FCell* FDelegateMailbox::BeginPost(std::size_t& OutPosition)
+    {
+        std::size_t Position = PostPosition.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            FCell& Cell = Cells[Position & Mask];
+            const std::size_t Sequence = Cell.Sequence.load(std::memory_order_acquire);
+            const std::intptr_t Difference = static_cast<std::intptr_t>(Sequence) - static_cast<std::intptr_t>(Position);
+
+            if (Difference == 0)
+            {
+                if (PostPosition.compare_exchange_weak(Position, Position + 1, std::memory_order_relaxed))
+                {
+                    OutPosition = Position;
+                    return &Cell;
+                }
+            }
+            else if (Difference < 0)
+            {
+                // The consumer has not freed this cell since the last lap: the ring is full.
+                NumDropped.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            else
+            {
+                Position = PostPosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    std::size_t FDelegateMailbox::Pump(std::size_t InMaxMessages)
+    {
+        assert(IsOwnerThread());
+        if (bPumping) return 0;
+
+        // Also runs if a message throws: the cell of the message running is freed and pumping ends.
+        struct FPumpScope
+        {
+            explicit FPumpScope(FDelegateMailbox& InMailbox) : Mailbox(InMailbox) { Mailbox.bPumping = true; }
+            ~FPumpScope()
+            {
+                if (Running) Mailbox.ReleaseCell(*Running);
+                Mailbox.bPumping = false;
+            }
+
+            FDelegateMailbox& Mailbox;
+            FCell* Running = nullptr;
+        };
+        FPumpScope Scope(*this);
+
+        // Stop at what was posted before this Pump began, so messages that post again cannot keep it running.
+        const std::size_t EndPosition = PostPosition.load(std::memory_order_acquire);
+
+        std::size_t NumRun = 0;
+        while (NumRun < InMaxMessages && PumpPosition != EndPosition)
+        {
+            FCell& Cell = Cells[PumpPosition & Mask];
+
+            // Claimed but still being written; it is picked up by a later Pump.
+            if (Cell.Sequence.load(std::memory_order_acquire) != PumpPosition + 1) break;
+
+            Scope.Running = &Cell;
+            Cell.Run(Cell.Message, true);
+            Scope.Running = nullptr;
+
+            ReleaseCell(Cell);
+            ++NumRun;
+        }
+
+        return NumRun;
+    }
+}
@@ -0,0 +1,119 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace Delegates
+{
+    // ======================= Mailbox =======================
+
+    // Bounded lock-free multi-producer, single-consumer ring of messages for one thread, e.g. the game thread.
+    // Any thread posts; the owning thread runs what was posted when it calls Pump at its pump point. A message is a
+    // callable stored inline in a fixed-size cell, so posting takes no lock and allocates nothing. When the ring is
+    // full the message is dropped and counted rather than making the producer wait on the consumer.
+    //
+    // TThreadSafeMulticastDelegate bindings tagged with a mailbox are marshalled through it (see AddRaw etc.).
+    class FDelegateMailbox
+    {
+    public:
+        // Largest message a cell holds, e.g. a listener reference plus a 32-byte argument tuple.
+        static constexpr std::size_t MaxMessageSize = 48;
+
+        // The calling thread becomes the owner. InCapacity is rounded up to a power of two.
+        explicit FDelegateMailbox(std::size_t InCapacity = 1024);
+
+        // Messages still queued are destroyed without being run.
+        ~FDelegateMailbox();
+
+        FDelegateMailbox(const FDelegateMailbox&) = delete;
+        FDelegateMailbox& operator=(const FDelegateMailbox&) = delete;
+
+        __forceinline bool IsOwnerThread() const { return std::this_thread::get_id() == OwnerThread; }
+        __forceinline std::size_t GetCapacity() const { return Mask + 1; }
+        __forceinline uint64_t GetNumDropped() const { return NumDropped.load(std::memory_order_relaxed); }
+
+        // Hands the mailbox to the calling thread, e.g. one created before the game thread started. Only while no
+        // other thread pumps it.
+        __forceinline void SetOwnerThread() { OwnerThread = std::this_thread::get_id(); }
+
+        // Thread-safe and wait-free unless other producers race for the same cell. Returns false if the ring was full.
+        // Once a cell is claimed it must be published, so the message is moved into it and that move may not throw:
+        // build the message (copying its arguments) before posting it.
+        template <typename MessageType>
+        [[nodiscard]] bool TryPost(MessageType&& InMessage)
+        {
+            using FMessage = std::decay_t<MessageType>;
+            static_assert(sizeof(FMessage) <= MaxMessageSize && alignof(FMessage) <= alignof(std::max_align_t), "Message does not fit a mailbox cell");
+            static_assert(std::is_invocable_v<FMessage&>, "Message must be callable without arguments");
+            static_assert(std::is_nothrow_constructible_v<FMessage, MessageType&&>, "Message must be posted as an rvalue with a non-throwing move");
+
+            std::size_t Position;
+            FCell* Cell = BeginPost(Position);
+            if (!Cell) return false;
+
+            new (Cell->Message) FMessage(std::forward<MessageType>(InMessage));
+            Cell->Run = &RunMessage<FMessage>;
+            Cell->Sequence.store(Position + 1, std::memory_order_release);
+            return true;
+        }
+
+        // Owner thread only: runs the messages posted so far, oldest first, at most InMaxMessages of them, and returns
+        // how many ran. Messages posted by the ones running are left for the next Pump. Calls from inside a message
+        // return 0. A message that throws is destroyed and its cell freed before the exception leaves Pump, so later
+        // Pumps carry on with the next message.
+        std::size_t Pump(std::size_t InMaxMessages = SIZE_MAX);
+
+    private:
+        // Runs (bInRun) or just destroys the message in place.
+        using FRunFunc = void(*)(void* InMessage, bool bInRun);
+
+        // Sequence tells whose turn the cell is: equal to the position for the producer that may claim it,
+        // position + 1 once its message is ready for the consumer. One cache line per cell.
+        struct alignas(64) FCell
+        {
+            std::atomic<std::size_t> Sequence{ 0 };
+            FRunFunc Run = nullptr;
+            alignas(std::max_align_t) unsigned char Message[MaxMessageSize];
+        };
+
+        template <typename MessageType>
+        static void RunMessage(void* InMessage, bool bInRun)
+        {
+            struct FDestroyScope
+            {
+                ~FDestroyScope() { Message.~MessageType(); }
+                MessageType& Message;
+            };
+
+            FDestroyScope Scope{ *std::launder(static_cast<MessageType*>(InMessage)) };
+            if (bInRun) Scope.Message();
+        }
+
+        // Claims the next free cell and its position, or returns null (and counts the drop) if the ring is full.
+        FCell* BeginPost(std::size_t& OutPosition);
+
+        // Consumer side: hands the cell at PumpPosition back to the producers for the next lap.
+        __forceinline void ReleaseCell(FCell& InCell)
+        {
+            InCell.Sequence.store(PumpPosition + Mask + 1, std::memory_order_release);
+            ++PumpPosition;
+        }
+
+    private:
+        std::unique_ptr<FCell[]> Cells;
+        std::size_t Mask = 0;
+
+        alignas(64) std::atomic<std::size_t> PostPosition{ 0 };
+        std::atomic<uint64_t> NumDropped{ 0 };
+
+        // Consumer side.
+        alignas(64) std::size_t PumpPosition = 0;
+        std::thread::id OwnerThread;
+        bool bPumping = false;
+    };
+}
@@ -0,0 +1,273 @@
+#include "DelegateStats.h"
+
+#if DELEGATES_WITH_STATS
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace Delegates
+{
+    namespace
+    {
+        const char* const UnnamedName = "<unnamed>";
+
+        constexpr std::size_t NumBuckets = FDelegateStatReport::NumHistogramBuckets;
+
+        // One delegate (ListenerName null) or listener in one thread's table. The names are written before bUsed is
+        // published, so readers that see bUsed also see them; the counters have a single writer, the table's thread.
+        struct FStatRecord
+        {
+            std::atomic<bool> bUsed{ false };
+            const char* DelegateName = nullptr;
+            const char* ListenerName = nullptr;
+
+            std::atomic<uint64_t> NumBroadcasts{ 0 };
+            std::atomic<uint64_t> NumCalls{ 0 };
+            std::atomic<uint64_t> TotalNanoseconds{ 0 };
+            std::atomic<uint64_t> NumCompactions{ 0 };
+            std::atomic<uint64_t> NumAllocations{ 0 };
+            std::atomic<uint64_t> Histogram[NumBuckets];
+        };
+
+        // Single writer, so a relaxed load and store is enough and recording needs no locked instructions.
+        __forceinline void Add(std::atomic<uint64_t>& InCounter, uint64_t InValue)
+        {
+            InCounter.store(InCounter.load(std::memory_order_relaxed) + InValue, std::memory_order_relaxed);
+        }
+
+        __forceinline std::size_t GetBucket(uint64_t InNanoseconds)
+        {
+            const std::size_t Bucket = InNanoseconds > 0 ? static_cast<std::size_t>(std::bit_width(InNanoseconds)) - 1 : 0;
+            return std::min(Bucket, NumBuckets - 1);
+        }
+
+        // Open-addressed on the name pointers; a full table drops new keys rather than growing under readers.
+        struct FThreadTable
+        {
+            static constexpr std::size_t Capacity = 512;
+
+            FStatRecord* Find(const char* InDelegateName, const char* InListenerName)
+            {
+                const uint64_t Hash = (reinterpret_cast<uintptr_t>(InDelegateName) * 0x9E3779B97F4A7C15ull) ^
+                    (reinterpret_cast<uintptr_t>(InListenerName) * 0xC2B2AE3D27D4EB4Full);
+
+                for (std::size_t Probe = 0; Probe < Capacity; ++Probe)
+                {
+                    FStatRecord& Record = Records[((Hash >> 32) + Probe) & (Capacity - 1)];
+                    if (!Record.bUsed.load(std::memory_order_relaxed))
+                    {
+                        Record.DelegateName = InDelegateName;
+                        Record.ListenerName = InListenerName;
+                        Record.bUsed.store(true, std::memory_order_release);
+                        return &Record;
+                    }
+                    if (Record.DelegateName == InDelegateName && Record.ListenerName == InListenerName) return &Record;
+                }
+
+                return nullptr;
+            }
+
+            FStatRecord Records[Capacity];
+        };
+
+        // Tables outlive their threads: an exiting thread hands its table, counts included, to the next new thread.
+        struct FRegistry
+        {
+            std::mutex Mutex;
+            std::vector<std::unique_ptr<FThreadTable>> Tables;
+            std::vector<FThreadTable*> FreeTables;
+        };
+
+        // Never destroyed, so threads still recording during static destruction find it.
+        FRegistry& GetRegistry()
+        {
+            static FRegistry* Registry = new FRegistry();
+            return *Registry;
+        }
+
+        struct FThreadTableHandle
+        {
+            FThreadTableHandle()
+            {
+                FRegistry& Registry = GetRegistry();
+                std::lock_guard<std::mutex> Lock(Registry.Mutex);
+
+                if (!Registry.FreeTables.empty())
+                {
+                    Table = Registry.FreeTables.back();
+                    Registry.FreeTables.pop_back();
+                    return;
+                }
+
+                Registry.Tables.push_back(std::make_unique<FThreadTable>());
+                Table = Registry.Tables.back().get();
+            }
+
+            ~FThreadTableHandle()
+            {
+                FRegistry& Registry = GetRegistry();
+                std::lock_guard<std::mutex> Lock(Registry.Mutex);
+                Registry.FreeTables.push_back(Table);
+            }
+
+            FThreadTable* Table = nullptr;
+        };
+
+        FStatRecord* FindRecord(const char* InDelegateName, const char* InListenerName)
+        {
+            thread_local FThreadTableHandle Handle;
+            return Handle.Table->Find(InDelegateName ? InDelegateName : UnnamedName, InListenerName);
+        }
+
+        // Upper bound of the bucket holding the InFraction-th call.
+        uint64_t GetPercentile(const FDelegateStatReport& InReport, double InFraction)
+        {
+            uint64_t NumCounted = 0;
+            for (uint64_t Count : InReport.Histogram) NumCounted += Count;
+            if (NumCounted == 0) return 0;
+
+            const uint64_t Target = static_cast<uint64_t>(static_cast<double>(NumCounted - 1) * InFraction) + 1;
+            uint64_t Seen = 0;
+            for (std::size_t Bucket = 0; Bucket < NumBuckets; ++Bucket)
+            {
+                Seen += InReport.Histogram[Bucket];
+                if (Seen >= Target) return uint64_t(2) << Bucket;
+            }
+            return uint64_t(2) << (NumBuckets - 1);
+        }
+    }
+
+    // ======================= FDelegateStats =======================
+
+    std::atomic<bool> FDelegateStats::bEnabled(false);
+    std::atomic<FDelegateStats::FScopeCallback> FDelegateStats::BeginScope(nullptr);
+    std::atomic<FDelegateStats::FScopeCallback> FDelegateStats::EndScope(nullptr);
+
+    void FDelegateStats::SetEnabled(bool bInEnabled)
+    {
+        bEnabled.store(bInEnabled, std::memory_order_relaxed);
+    }
+
+    void FDelegateStats::SetScopeCallbacks(FScopeCallback InBegin, FScopeCallback InEnd)
+    {
+        BeginScope.store(InBegin, std::memory_order_relaxed);
+        EndScope.store(InEnd, std::memory_order_relaxed);
+    }
+
+    void FDelegateStats::RecordBroadcast(const char* InDelegateName, uint64_t InNumListeners, uint64_t InNanoseconds)
+    {
+        FStatRecord* Record = FindRecord(InDelegateName, nullptr);
+        if (!Record) return;
+
+        Add(Record->NumBroadcasts, 1);
+        Add(Record->NumCalls, InNumListeners);
+        Add(Record->TotalNanoseconds, InNanoseconds);
+        Add(Record->Histogram[GetBucket(InNanoseconds)], 1);
+    }
+
+    void FDelegateStats::RecordListener(const char* InDelegateName, const char* InListenerName, uint64_t InNanoseconds)
+    {
+        FStatRecord* Record = FindRecord(InDelegateName, InListenerName ? InListenerName : UnnamedName);
+        if (!Record) return;
+
+        Add(Record->NumCalls, 1);
+        Add(Record->TotalNanoseconds, InNanoseconds);
+        Add(Record->Histogram[GetBucket(InNanoseconds)], 1);
+    }
+
+    void FDelegateStats::RecordCompaction(const char* InDelegateName)
+    {
+        if (FStatRecord* Record = FindRecord(InDelegateName, nullptr)) Add(Record->NumCompactions, 1);
+    }
+
+    void FDelegateStats::RecordAllocation(const char* InDelegateName)
+    {
+        if (FStatRecord* Record = FindRecord(InDelegateName, nullptr)) Add(Record->NumAllocations, 1);
+    }
+
+    std::vector<FDelegateStatReport> FDelegateStats::GetReports()
+    {
+        // Merged by name rather than pointer, so equal literals from different translation units add up.
+        std::map<std::pair<std::string, std::string>, FDelegateStatReport> Merged;
+
+        FRegistry& Registry = GetRegistry();
+        std::lock_guard<std::mutex> Lock(Registry.Mutex);
+
+        for (const std::unique_ptr<FThreadTable>& Table : Registry.Tables)
+        {
+            for (const FStatRecord& Record : Table->Records)
+            {
+                if (!Record.bUsed.load(std::memory_order_acquire)) continue;
+
+                const std::string ListenerName = Record.ListenerName ? Record.ListenerName : "";
+                FDelegateStatReport& Report = Merged[{ Record.DelegateName, ListenerName }];
+                Report.DelegateName = Record.DelegateName;
+                Report.ListenerName = ListenerName;
+
+                Report.NumBroadcasts += Record.NumBroadcasts.load(std::memory_order_relaxed);
+                Report.NumCalls += Record.NumCalls.load(std::memory_order_relaxed);
+                Report.TotalNanoseconds += Record.TotalNanoseconds.load(std::memory_order_relaxed);
+                Report.NumCompactions += Record.NumCompactions.load(std::memory_order_relaxed);
+                Report.NumAllocations += Record.NumAllocations.load(std::memory_order_relaxed);
+                for (std::size_t Bucket = 0; Bucket < NumBuckets; ++Bucket) Report.Histogram[Bucket] += Record.Histogram[Bucket].load(std::memory_order_relaxed);
+            }
+        }
+
+        std::vector<FDelegateStatReport> Reports;
+        Reports.reserve(Merged.size());
+        for (auto& Entry : Merged) Reports.push_back(std::move(Entry.second));
+        return Reports;
+    }
+
+    void FDelegateStats::Dump(std::FILE* InFile)
+    {
+        std::fprintf(InFile, "%-32s %-24s %10s %12s %12s %10s %10s %10s %8s %8s\n",
+            "Delegate", "Listener", "Broadcasts", "Calls", "Total us", "Avg ns", "p50 ns", "p99 ns", "Compacts", "Allocs");
+
+        for (const FDelegateStatReport& Report : GetReports())
+        {
+            // Listener rows are indented under their delegate's row.
+            const bool bListener = !Report.ListenerName.empty();
+            const uint64_t NumTimed = bListener ? Report.NumCalls : Report.NumBroadcasts;
+
+            std::fprintf(InFile, "%-32s %-24s %10llu %12llu %12.1f %10llu %10llu %10llu %8llu %8llu\n",
+                bListener ? "" : Report.DelegateName.c_str(), bListener ? Report.ListenerName.c_str() : "",
+                static_cast<unsigned long long>(Report.NumBroadcasts), static_cast<unsigned long long>(Report.NumCalls),
+                static_cast<double>(Report.TotalNanoseconds) / 1000.0,
+                static_cast<unsigned long long>(NumTimed > 0 ? Report.TotalNanoseconds / NumTimed : 0),
+                static_cast<unsigned long long>(GetPercentile(Report, 0.5)), static_cast<unsigned long long>(GetPercentile(Report, 0.99)),
+                static_cast<unsigned long long>(Report.NumCompactions), static_cast<unsigned long long>(Report.NumAllocations));
+        }
+    }
+
+    void FDelegateStats::Reset()
+    {
+        FRegistry& Registry = GetRegistry();
+        std::lock_guard<std::mutex> Lock(Registry.Mutex);
+
+        for (const std::unique_ptr<FThreadTable>& Table : Registry.Tables)
+        {
+            for (FStatRecord& Record : Table->Records)
+            {
+                Record.NumBroadcasts.store(0, std::memory_order_relaxed);
+                Record.NumCalls.store(0, std::memory_order_relaxed);
+                Record.TotalNanoseconds.store(0, std::memory_order_relaxed);
+                Record.NumCompactions.store(0, std::memory_order_relaxed);
+                Record.NumAllocations.store(0, std::memory_order_relaxed);
+                for (std::atomic<uint64_t>& Count : Record.Histogram) Count.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    uint64_t FDelegateStats::GetTimeNanoseconds()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+}
+
+#endif
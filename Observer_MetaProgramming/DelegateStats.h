@@ -0,0 +1,140 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Instrumentation of TMulticastDelegate: broadcast and listener counts, per-listener latency histograms, compactions
+// and allocations, keyed by the debug names of the delegate and its listeners. Compiled out unless the build defines
+// DELEGATES_WITH_STATS=1; even then recording only starts once FDelegateStats::SetEnabled(true) is called.
+#ifndef DELEGATES_WITH_STATS
+#define DELEGATES_WITH_STATS 0
+#endif
+
+#if DELEGATES_WITH_STATS
+
+namespace Delegates
+{
+    // Totals for one delegate (ListenerName empty) or one of its listeners, summed over every thread that reported.
+    struct FDelegateStatReport
+    {
+        // Bucket Index counts calls that took [2^Index, 2^(Index + 1)) nanoseconds; the last one also takes the rest.
+        static constexpr std::size_t NumHistogramBuckets = 24;
+
+        std::string DelegateName;
+        std::string ListenerName;
+
+        uint64_t NumBroadcasts = 0;
+        // For a delegate, the listeners its broadcasts called; for a listener, its calls.
+        uint64_t NumCalls = 0;
+        uint64_t TotalNanoseconds = 0;
+        uint64_t NumCompactions = 0;
+        // Listener array growths and listeners whose instance did not fit inline.
+        uint64_t NumAllocations = 0;
+
+        uint64_t Histogram[NumHistogramBuckets] = {};
+    };
+
+    class FDelegateStats
+    {
+    public:
+        // Called around every instrumented broadcast (InListenerName null) and listener call, e.g. to open a Tracy
+        // zone or emit an ETW event. The names are the delegate's and listener's debug names.
+        using FScopeCallback = void(*)(const char* InDelegateName, const char* InListenerName);
+
+        static void SetEnabled(bool bInEnabled);
+        static __forceinline bool IsEnabled() { return bEnabled.load(std::memory_order_relaxed); }
+
+        static void SetScopeCallbacks(FScopeCallback InBegin, FScopeCallback InEnd);
+        static __forceinline FScopeCallback GetBeginScope() { return BeginScope.load(std::memory_order_relaxed); }
+        static __forceinline FScopeCallback GetEndScope() { return EndScope.load(std::memory_order_relaxed); }
+
+        // Recording is lock-free: each thread writes its own table, which only its owner ever writes.
+        // Names must outlive the stats (string literals); unnamed delegates and listeners share "<unnamed>".
+        static void RecordBroadcast(const char* InDelegateName, uint64_t InNumListeners, uint64_t InNanoseconds);
+        static void RecordListener(const char* InDelegateName, const char* InListenerName, uint64_t InNanoseconds);
+        static void RecordCompaction(const char* InDelegateName);
+        static void RecordAllocation(const char* InDelegateName);
+
+        // Merges the tables of all threads, including exited ones. Can run while other threads keep recording.
+        static std::vector<FDelegateStatReport> GetReports();
+        static void Dump(std::FILE* InFile = stdout);
+
+        // Zeroes every table. Counts recorded concurrently with the reset may be partly lost.
+        static void Reset();
+
+        static uint64_t GetTimeNanoseconds();
+
+    private:
+        static std::atomic<bool> bEnabled;
+        static std::atomic<FScopeCallback> BeginScope;
+        static std::atomic<FScopeCallback> EndScope;
+    };
+
+    // Times one broadcast; the delegate counts the listeners it calls into NumListeners.
+    class FDelegateBroadcastStatScope
+    {
+    public:
+        explicit FDelegateBroadcastStatScope(const char* InDelegateName)
+            : DelegateName(InDelegateName), bActive(FDelegateStats::IsEnabled())
+        {
+            if (!bActive) return;
+
+            if (FDelegateStats::FScopeCallback Begin = FDelegateStats::GetBeginScope()) Begin(DelegateName, nullptr);
+            StartNanoseconds = FDelegateStats::GetTimeNanoseconds();
+        }
+
+        ~FDelegateBroadcastStatScope()
+        {
+            if (!bActive) return;
+
+            FDelegateStats::RecordBroadcast(DelegateName, NumListeners, FDelegateStats::GetTimeNanoseconds() - StartNanoseconds);
+            if (FDelegateStats::FScopeCallback End = FDelegateStats::GetEndScope()) End(DelegateName, nullptr);
+        }
+
+        FDelegateBroadcastStatScope(const FDelegateBroadcastStatScope&) = delete;
+        FDelegateBroadcastStatScope& operator=(const FDelegateBroadcastStatScope&) = delete;
+
+        uint64_t NumListeners = 0;
+
+    private:
+        const char* DelegateName;
+        uint64_t StartNanoseconds = 0;
+        bool bActive;
+    };
+
+    // Times one listener call.
+    class FDelegateListenerStatScope
+    {
+    public:
+        FDelegateListenerStatScope(const char* InDelegateName, const char* InListenerName)
+            : DelegateName(InDelegateName), ListenerName(InListenerName), bActive(FDelegateStats::IsEnabled())
+        {
+            if (!bActive) return;
+
+            if (FDelegateStats::FScopeCallback Begin = FDelegateStats::GetBeginScope()) Begin(DelegateName, ListenerName);
+            StartNanoseconds = FDelegateStats::GetTimeNanoseconds();
+        }
+
+        ~FDelegateListenerStatScope()
+        {
+            if (!bActive) return;
+
+            FDelegateStats::RecordListener(DelegateName, ListenerName, FDelegateStats::GetTimeNanoseconds() - StartNanoseconds);
+            if (FDelegateStats::FScopeCallback End = FDelegateStats::GetEndScope()) End(DelegateName, ListenerName);
+        }
+
+        FDelegateListenerStatScope(const FDelegateListenerStatScope&) = delete;
+        FDelegateListenerStatScope& operator=(const FDelegateListenerStatScope&) = delete;
+
+    private:
+        const char* DelegateName;
+        const char* ListenerName;
+        uint64_t StartNanoseconds = 0;
+        bool bActive;
+    };
+}
+
+#endif
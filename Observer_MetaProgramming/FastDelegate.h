@@ -0,0 +1,110 @@
+#pragma once
+#include <type_traits>
+#include <utility>
+
+#include "DelegateInstance.h"
+#include "StaticMulticastDelegate.h"
+
+namespace Delegates
+{
+    // ======================= TFastDelegate =======================
+
+    // Unicast delegate for a free function or raw member function fixed at compile time, as in the classic
+    // "impossibly fast delegates": a binding is the object pointer plus a thunk instantiated for that one function.
+    // No vtable, no heap, trivially copyable; a call is one indirect call to the thunk, which calls the bound
+    // function directly. Weak objects, lambdas and functions chosen at runtime need TDelegate.
+    //
+    // Handles behave as in TDelegate: every bind generates a new one, and a copy is the same binding, handle included.
+    //
+    //   TFastDelegate<void(int, int, int)> OnHealthChanged;
+    //   OnHealthChanged.BindRaw<&Logger::Update>(&Log);
+    template <typename Signature>
+    class TFastDelegate;
+
+    template <typename RetType, typename... ArgsType>
+    class TFastDelegate<RetType(ArgsType...)>
+    {
+        using FThunk = RetType(*)(void* InObject, TDelegateParam<ArgsType>... Args);
+
+        template <auto Listener>
+        using TObjectType = typename TStaticListenerTraits<RetType(ArgsType...), std::remove_cv_t<decltype(Listener)>>::ObjectType;
+
+    public:
+        TFastDelegate() = default;
+
+        __forceinline bool IsBound() const { return Thunk != nullptr; }
+        __forceinline FDelegateHandle GetHandle() const { return Handle; }
+
+        // The bound object, or null for a free function.
+        __forceinline const void* GetObject() const { return Object; }
+
+        void Unbind()
+        {
+            Object = nullptr;
+            Thunk = nullptr;
+            Handle.Reset();
+        }
+
+        template <auto Function>
+        void BindStatic()
+        {
+            static_assert(!TStaticListenerTraits<RetType(ArgsType...), std::remove_cv_t<decltype(Function)>>::bIsMember, "BindStatic expects a free function");
+
+            Bind(nullptr, &CallStatic<Function>);
+        }
+
+        template <auto Method>
+        void BindRaw(TObjectType<Method>* InObjPtr)
+        {
+            static_assert(TStaticListenerTraits<RetType(ArgsType...), std::remove_cv_t<decltype(Method)>>::bIsMember, "BindRaw expects a member function");
+            assert(InObjPtr);
+
+            Bind(const_cast<void*>(static_cast<const void*>(InObjPtr)), &CallRaw<Method>);
+        }
+
+        __forceinline RetType Execute(TDelegateParam<ArgsType>... Args) const
+        {
+            assert(IsBound());
+            return Thunk(Object, std::forward<TDelegateParam<ArgsType>>(Args)...);
+        }
+
+        __forceinline RetType ExecuteIfBound(TDelegateParam<ArgsType>... Args) const
+        {
+            if (!Thunk) return RetType();
+            return Thunk(Object, std::forward<TDelegateParam<ArgsType>>(Args)...);
+        }
+
+        __forceinline bool TryExecute(TDelegateParam<ArgsType>... Args) const
+        {
+            if (!Thunk) return false;
+
+            Thunk(Object, std::forward<TDelegateParam<ArgsType>>(Args)...);
+            return true;
+        }
+
+    private:
+        __forceinline void Bind(void* InObject, FThunk InThunk)
+        {
+            Object = InObject;
+            Thunk = InThunk;
+            Handle = FDelegateHandle(FDelegateHandle::GenerateNewHandle);
+        }
+
+        template <auto Function>
+        static RetType CallStatic(void*, TDelegateParam<ArgsType>... Args)
+        {
+            return Function(std::forward<TDelegateParam<ArgsType>>(Args)...);
+        }
+
+        template <auto Method>
+        static RetType CallRaw(void* InObject, TDelegateParam<ArgsType>... Args)
+        {
+            return (static_cast<TObjectType<Method>*>(InObject)->*Method)(std::forward<TDelegateParam<ArgsType>>(Args)...);
+        }
+
+    private:
+        void* Object = nullptr;
+        FThunk Thunk = nullptr;
+        FDelegateHandle Handle;
+    };
+}
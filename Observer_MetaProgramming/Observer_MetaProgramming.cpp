@@ -69,5 +69,12 @@ int main(int argc, char* argv[])
 
     std::cout << "\n";
 
+    // A higher priority runs first whatever the bind order: the Logger bound last still reports before the HUD.
+    Player.OnHealthChanged.AddRaw(&Log, &Logger::Update, 1);
+
+    Player.ApplyHealthChanged(-20);
+
+    std::cout << "\n";
+
     return 0;
 }
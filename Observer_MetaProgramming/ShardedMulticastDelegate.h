@@ -0,0 +1,330 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "DelegateInstance.h"
+
+namespace Delegates
+{
+    // ======================= TShardedMulticastDelegate =======================
+
+    // Multicast delegate for very large listener counts (100k+ listeners on a global event). Listeners live in
+    // shards of at most ShardCapacity, each a TMulticastDelegate whose arrays are reserved up front. Adding never
+    // reallocates or copies the listeners already bound, just one pointer per shard. Remove only touches the
+    // listener's own shard, and so does the compaction that follows it.
+    //
+    // A handle's slot holds the shard index as well as the listener's slot within the shard. Broadcast walks the shards
+    // in order, and so does ParallelBroadcast, spreading each shard's AnyThread listeners over the executor in turn.
+    // Priorities order listeners within their shard only. As with TMulticastDelegate, listeners added during a broadcast are not called by it.
+    //
+    //   TShardedMulticastDelegate<void(double)> OnWorldTimeChanged;
+    template <typename Signature, uint32_t ShardCapacity = 1024, typename Allocator = FDelegateHeapAllocator>
+    class TShardedMulticastDelegate;
+
+    template <typename RetType, typename... ArgsType, uint32_t ShardCapacity, typename Allocator>
+    class TShardedMulticastDelegate<RetType(ArgsType...), ShardCapacity, Allocator>
+    {
+        static_assert(std::has_single_bit(ShardCapacity), "ShardCapacity must be a power of two");
+
+        using FShard = TMulticastDelegate<RetType(ArgsType...), Allocator>;
+
+        static constexpr uint32_t MaxNumShards = UINT32_MAX / ShardCapacity;
+
+        // What the running broadcasts have left to visit: shards after Current and before End. Adds go elsewhere.
+        struct FBroadcastRange
+        {
+            uint32_t Current = UINT32_MAX;
+            uint32_t End = 0;
+        };
+
+        struct FRangeScope
+        {
+            explicit FRangeScope(TShardedMulticastDelegate& InOwner) : Owner(InOwner), Saved(InOwner.Range) {}
+            ~FRangeScope() { Owner.Range = Saved; }
+
+            FRangeScope(const FRangeScope&) = delete;
+            FRangeScope& operator=(const FRangeScope&) = delete;
+
+            TShardedMulticastDelegate& Owner;
+            const FBroadcastRange Saved;
+        };
+
+    public:
+        TShardedMulticastDelegate() = default;
+        explicit TShardedMulticastDelegate(const char* InDebugName) : DebugName(InDebugName) {}
+
+        TShardedMulticastDelegate(const TShardedMulticastDelegate&) = delete;
+        TShardedMulticastDelegate& operator=(const TShardedMulticastDelegate&) = delete;
+
+        bool IsBound() const
+        {
+            return std::any_of(Shards.begin(), Shards.end(), [](const std::unique_ptr<FShard>& InShard) { return InShard->IsBound(); });
+        }
+
+        __forceinline size_t GetNumShards() const { return Shards.size(); }
+
+        // Unbinds every listener but keeps the shards, and their memory, for the next ones.
+        void Clear()
+        {
+            for (std::unique_ptr<FShard>& Shard : Shards) Shard->Clear();
+            bRescanShards = true;
+        }
+
+        FDelegateHandle AddStatic(TFuncPtr<RetType(ArgsType...)> Fn, const FDelegateBindOptions& InOptions = {})
+        {
+            const uint32_t Shard = FindShardForAdd();
+            return ToShardedHandle(Shard, Shards[Shard]->AddStatic(Fn, InOptions));
+        }
+
+        template<typename Class>
+        FDelegateHandle AddRaw(Class* InObjPtr, TMemFuncPtr<Class, RetType(ArgsType...)> InMethod, const FDelegateBindOptions& InOptions = {})
+        {
+            const uint32_t Shard = FindShardForAdd();
+            return ToShardedHandle(Shard, Shards[Shard]->AddRaw(InObjPtr, InMethod, InOptions));
+        }
+        template<typename Class>
+        FDelegateHandle AddRaw(const Class* InObjPtr, TMemFuncPtr<const Class, RetType(ArgsType...)> InMethod, const FDelegateBindOptions& InOptions = {})
+        {
+            const uint32_t Shard = FindShardForAdd();
+            return ToShardedHandle(Shard, Shards[Shard]->AddRaw(InObjPtr, InMethod, InOptions));
+        }
+
+        template <auto Function>
+        FDelegateHandle AddStatic(const FDelegateBindOptions& InOptions = {})
+        {
+            const uint32_t Shard = FindShardForAdd();
+            return ToShardedHandle(Shard, Shards[Shard]->template AddStatic<Function>(InOptions));
+        }
+
+        template <auto Method, typename Class>
+        FDelegateHandle AddRaw(Class* InObjPtr, const FDelegateBindOptions& InOptions = {})
+        {
+            const uint32_t Shard = FindShardForAdd();
+            return ToShardedHandle(Shard, Shards[Shard]->template AddRaw<Method>(InObjPtr, InOptions));
+        }
+
+        template<typename Class>
+        FDelegateHandle AddWeak(std::weak_ptr<Class> InWeak, TMemFuncPtr<Class, RetType(ArgsType...)> InMethod, const FDelegateBindOptions& InOptions = {})
+        {
+            const uint32_t Shard = FindShardForAdd();
+            return ToShardedHandle(Shard, Shards[Shard]->AddWeak(std::move(InWeak), InMethod, InOptions));
+        }
+        template<typename Class>
+        FDelegateHandle AddWeak(std::weak_ptr<const Class> InWeak, TMemFuncPtr<const Class, RetType(ArgsType...)> InMethod, const FDelegateBindOptions& InOptions = {})
+        {
+            const uint32_t Shard = FindShardForAdd();
+            return ToShardedHandle(Shard, Shards[Shard]->AddWeak(std::move(InWeak), InMethod, InOptions));
+        }
+
+        template<typename Func>
+        FDelegateHandle AddLambda(Func&& InFunc, const FDelegateBindOptions& InOptions = {})
+        {
+            return AddLambda(nullptr, std::forward<Func>(InFunc), InOptions);
+        }
+
+        template<typename Func>
+        FDelegateHandle AddLambda(const void* InOwner, Func&& InFunc, const FDelegateBindOptions& InOptions = {})
+        {
+            const uint32_t Shard = FindShardForAdd();
+            return ToShardedHandle(Shard, Shards[Shard]->AddLambda(InOwner, std::forward<Func>(InFunc), InOptions));
+        }
+
+        // O(1), in the listener's shard only.
+        void Remove(FDelegateHandle InHandle)
+        {
+            if (!InHandle.IsValid() || InHandle.GetSlot() == FDelegateHandle::InvalidSlot) return;
+
+            const uint32_t Shard = InHandle.GetSlot() / ShardCapacity;
+            if (Shard >= Shards.size()) return;
+
+            FShard& Target = *Shards[Shard];
+            const bool bWasFull = Target.GetNumSlotsInUse() >= ShardCapacity;
+            const bool bHadRemoved = Target.GetNumRemoved() > 0;
+            Target.Remove(InHandle.WithSlot(InHandle.GetSlot() % ShardCapacity));
+
+            // The first removal from a full shard gives it room, even if the shard is below its compaction threshold:
+            // FindShardForAdd compacts it before it would add a shard.
+            if (bWasFull && !bHadRemoved) ShardsWithRoom.push_back(Shard);
+        }
+
+        // One owner lookup per shard, then proportional to the owner's own listeners.
+        void RemoveAll(const void* InOwner)
+        {
+            for (std::unique_ptr<FShard>& Shard : Shards) Shard->RemoveAll(InOwner);
+            bRescanShards = true;
+        }
+
+        void Broadcast(TDelegateParam<ArgsType>... Args)
+        {
+            // A listener may add a shard, so the pointers are read by index; new shards are not visited.
+            const uint32_t NumShards = static_cast<uint32_t>(Shards.size());
+
+            FRangeScope Scope(*this);
+            Range.End = std::max(Scope.Saved.End, NumShards);
+
+            for (uint32_t Shard = 0; Shard < NumShards; ++Shard)
+            {
+                Range.Current = std::min(Scope.Saved.Current, Shard);
+                Shards[Shard]->Broadcast(std::forward<TDelegateParam<ArgsType>>(Args)...);
+            }
+
+            // Shards compact dead listeners when their broadcast ends.
+            bRescanShards = true;
+        }
+
+        // See TMulticastDelegate::BroadcastKeyed; each shard scans its own keys.
+        void BroadcastKeyed(uint32_t InKey, TDelegateParam<ArgsType>... Args)
+        {
+            const uint32_t NumShards = static_cast<uint32_t>(Shards.size());
+
+            FRangeScope Scope(*this);
+            Range.End = std::max(Scope.Saved.End, NumShards);
+
+            for (uint32_t Shard = 0; Shard < NumShards; ++Shard)
+            {
+                Range.Current = std::min(Scope.Saved.Current, Shard);
+                Shards[Shard]->BroadcastKeyed(InKey, std::forward<TDelegateParam<ArgsType>>(Args)...);
+            }
+
+            bRescanShards = true;
+        }
+
+        // TMulticastDelegate::ParallelBroadcast over each shard in turn: a shard's AnyThread listeners are spread over
+        // InExecutor's workers and the calling thread, and its CallerThread listeners run on the calling thread, in
+        // priority bands, before the next shard starts. Returns when every listener has run. The same rules apply to
+        // the listeners: AnyThread ones must not touch this delegate, CallerThread ones may add and remove listeners
+        // like in Broadcast.
+        //
+        // ExecutorType needs the same GetNumWorkers/ParallelFor members as for TMulticastDelegate::ParallelBroadcast.
+        template <typename ExecutorType>
+        void ParallelBroadcast(ExecutorType& InExecutor, TDelegateParam<ArgsType>... Args)
+        {
+            static_assert((!std::is_rvalue_reference_v<TDelegateParam<ArgsType>> && ...), "ParallelBroadcast cannot hand one rvalue to several listeners at once");
+
+            const uint32_t NumShards = static_cast<uint32_t>(Shards.size());
+
+            FRangeScope Scope(*this);
+            Range.End = std::max(Scope.Saved.End, NumShards);
+
+            for (uint32_t Shard = 0; Shard < NumShards; ++Shard)
+            {
+                Range.Current = std::min(Scope.Saved.Current, Shard);
+                Shards[Shard]->ParallelBroadcast(InExecutor, Args...);
+            }
+
+            bRescanShards = true;
+        }
+
+        // Erases removed and dead listeners in every shard.
+        void Compact()
+        {
+            for (std::unique_ptr<FShard>& Shard : Shards) Shard->Compact();
+            bRescanShards = true;
+        }
+
+        // See TMulticastDelegate::GetMemoryFootprint.
+        size_t GetMemoryFootprint() const
+        {
+            size_t Bytes = sizeof(*this) + Shards.capacity() * sizeof(std::unique_ptr<FShard>) + ShardsWithRoom.capacity() * sizeof(uint32_t);
+            for (const std::unique_ptr<FShard>& Shard : Shards) Bytes += Shard->GetMemoryFootprint();
+            return Bytes;
+        }
+
+        // Shrinks every shard (see TMulticastDelegate::ShrinkToFit) and, outside a broadcast, frees the empty shards at
+        // the end. Shrunk shards no longer have their arrays reserved, so they reallocate as listeners are added again.
+        void ShrinkToFit()
+        {
+            for (std::unique_ptr<FShard>& Shard : Shards) Shard->ShrinkToFit();
+
+            if (Range.End == 0)
+            {
+                while (!Shards.empty() && Shards.back()->GetNumSlotsInUse() == 0 && !Shards.back()->IsBound()) Shards.pop_back();
+                Shards.shrink_to_fit();
+            }
+
+            std::erase_if(ShardsWithRoom, [this](uint32_t InShard) { return InShard >= Shards.size(); });
+            ShardsWithRoom.shrink_to_fit();
+            bRescanShards = true;
+        }
+
+        void SetCompactionThreshold(float InThreshold)
+        {
+            CompactionThreshold = InThreshold;
+            for (std::unique_ptr<FShard>& Shard : Shards) Shard->SetCompactionThreshold(InThreshold);
+        }
+
+    private:
+        // A shard takes a listener while its slots, removed listeners included, stay below ShardCapacity, so its local
+        // slots fit the handle. Shards a running broadcast has yet to reach are skipped. Once the open shard is full,
+        // the ones Remove made room in are tried, then every shard if a broadcast may have left dead listeners in one,
+        // and only then is a new shard added. A full shard holding removed listeners is compacted to take the add, so
+        // churn reuses the shards it has instead of growing new ones; that costs at most one shard's worth of moves.
+        uint32_t FindShardForAdd()
+        {
+            const auto CanAdd = [this](uint32_t InShard)
+            {
+                if (InShard > Range.Current && InShard < Range.End) return false;
+
+                FShard& Shard = *Shards[InShard];
+                if (Shard.GetNumSlotsInUse() >= ShardCapacity && Shard.GetNumRemoved() > 0 && !Shard.IsBroadcasting()) Shard.Compact();
+                return Shard.GetNumSlotsInUse() < ShardCapacity;
+            };
+
+            if (OpenShard < Shards.size() && CanAdd(OpenShard)) return OpenShard;
+
+            while (!ShardsWithRoom.empty())
+            {
+                const uint32_t Shard = ShardsWithRoom.back();
+                ShardsWithRoom.pop_back();
+                if (!CanAdd(Shard)) continue;
+
+                OpenShard = Shard;
+                return Shard;
+            }
+
+            if (bRescanShards)
+            {
+                // Mid-broadcast some shards are off limits, so look again afterwards.
+                bRescanShards = Range.End != 0;
+
+                for (uint32_t Shard = 0; Shard < Shards.size(); ++Shard)
+                {
+                    if (!CanAdd(Shard)) continue;
+
+                    OpenShard = Shard;
+                    return Shard;
+                }
+            }
+
+            assert(Shards.size() < MaxNumShards && "Too many listeners for the handle's slot");
+            Shards.push_back(std::make_unique<FShard>(DebugName));
+            Shards.back()->Reserve(ShardCapacity);
+            Shards.back()->SetCompactionThreshold(CompactionThreshold);
+
+            OpenShard = static_cast<uint32_t>(Shards.size() - 1);
+            return OpenShard;
+        }
+
+        static __forceinline FDelegateHandle ToShardedHandle(uint32_t InShard, FDelegateHandle InHandle)
+        {
+            assert(InHandle.GetSlot() < ShardCapacity);
+            return InHandle.WithSlot(InShard * ShardCapacity + InHandle.GetSlot());
+        }
+
+    private:
+        // Each shard is allocated on its own, so adding one only moves these pointers.
+        std::vector<std::unique_ptr<FShard>> Shards;
+        uint32_t OpenShard = 0;
+        TDelegateVector<uint32_t, Allocator> ShardsWithRoom;
+        bool bRescanShards = false;
+
+        FBroadcastRange Range;
+        float CompactionThreshold = FShard::DefaultCompactionThreshold;
+
+        const char* DebugName = nullptr;
+    };
+}
@@ -0,0 +1,194 @@
+#pragma once
+#include <array>
+#include <tuple>
+#include <utility>
+
+#include "DelegateInstance.h"
+
+namespace Delegates
+{
+    // ==================== Static Listener Traits ====================
+
+    template <typename Signature, typename ListenerType>
+    struct TStaticListenerTraits;
+
+    template <typename RetType, typename... ArgsType>
+    struct TStaticListenerTraits<RetType(ArgsType...), RetType(*)(ArgsType...)>
+    {
+        static_assert(std::is_same_v<RetType(*)(ArgsType...), TFuncPtr<RetType(ArgsType...)>>);
+
+        using ObjectType = void;
+        static constexpr bool bIsMember = false;
+    };
+
+    template <typename Class, typename RetType, typename... ArgsType>
+    struct TStaticListenerTraits<RetType(ArgsType...), RetType(Class::*)(ArgsType...)>
+    {
+        static_assert(std::is_same_v<RetType(Class::*)(ArgsType...), TMemFuncPtr<Class, RetType(ArgsType...)>>);
+
+        using ObjectType = Class;
+        static constexpr bool bIsMember = true;
+    };
+
+    template <typename Class, typename RetType, typename... ArgsType>
+    struct TStaticListenerTraits<RetType(ArgsType...), RetType(Class::*)(ArgsType...) const>
+    {
+        static_assert(std::is_same_v<RetType(Class::*)(ArgsType...) const, TMemFuncPtr<Class, RetType(ArgsType...) const>>);
+
+        using ObjectType = const Class;
+        static constexpr bool bIsMember = true;
+    };
+
+    // ======================= TStaticMulticastDelegate =======================
+
+    // Multicast delegate whose listener methods are fixed at compile time. Only the objects are bound at runtime,
+    // so Broadcast expands into direct (inlinable) calls: no vtable, no heap, no vector.
+    // Free function listeners are always bound; member listeners are called once their object is added.
+    //
+    //   using FOnHealthChanged = TStaticMulticastDelegate<void(int, int, int), &Logger::Update, &HUD::Update>;
+    template <typename Signature, auto... Listeners>
+    class TStaticMulticastDelegate;
+
+    template <typename RetType, typename... ArgsType, auto... Listeners>
+    class TStaticMulticastDelegate<RetType(ArgsType...), Listeners...>
+    {
+        template <std::size_t Index>
+        static constexpr auto ListenerAt = std::get<Index>(std::make_tuple(Listeners...));
+
+        template <std::size_t Index>
+        using TListenerTraits = TStaticListenerTraits<RetType(ArgsType...), std::remove_cv_t<decltype(ListenerAt<Index>)>>;
+
+        static constexpr std::size_t NumListeners = sizeof...(Listeners);
+
+        using FIndices = std::make_index_sequence<NumListeners>;
+
+    public:
+        bool IsBound() const { return IsBoundImpl(FIndices{}); }
+
+        void Clear()
+        {
+            Objects = {};
+            Handles = {};
+        }
+
+        template<typename Class>
+        FDelegateHandle AddRaw(Class* InObjPtr, TMemFuncPtr<Class, RetType(ArgsType...)> InMethod)
+        {
+            return AddRawImpl(InObjPtr, InMethod, FIndices{});
+        }
+        template<typename Class>
+        FDelegateHandle AddRaw(const Class* InObjPtr, TMemFuncPtr<Class, RetType(ArgsType...) const> InMethod)
+        {
+            return AddRawImpl(InObjPtr, InMethod, FIndices{});
+        }
+
+        void Remove(FDelegateHandle InHandle)
+        {
+            if (!InHandle.IsValid()) return;
+
+            RemoveIf([&](std::size_t Index, const void*) { return Handles[Index] == InHandle; }, FIndices{});
+        }
+
+        void RemoveAll(const void* InOwner)
+        {
+            if (!InOwner) return;
+
+            RemoveIf([&](std::size_t, const void* Object) { return Object == InOwner; }, FIndices{});
+        }
+
+        void Broadcast(TDelegateParam<ArgsType>... Args) const
+        {
+            BroadcastImpl(FIndices{}, Args...);
+        }
+
+    private:
+        template <std::size_t... Indices>
+        bool IsBoundImpl(std::index_sequence<Indices...>) const
+        {
+            return (IsBoundAt<Indices>() || ...);
+        }
+
+        template <std::size_t Index>
+        __forceinline bool IsBoundAt() const
+        {
+            if constexpr (TListenerTraits<Index>::bIsMember) return std::get<Index>(Objects) != nullptr;
+            else return true;
+        }
+
+        template <typename ObjectType, typename MethodType, std::size_t... Indices>
+        FDelegateHandle AddRawImpl(ObjectType* InObjPtr, MethodType InMethod, std::index_sequence<Indices...>)
+        {
+            FDelegateHandle Result;
+            if (InObjPtr) (TryBindAt<Indices>(InObjPtr, InMethod, Result) || ...);
+
+            assert(Result.IsValid() && "Method is not a listener of this delegate, or all of its slots are bound");
+            return Result;
+        }
+
+        template <std::size_t Index, typename ObjectType, typename MethodType>
+        bool TryBindAt(ObjectType* InObjPtr, MethodType InMethod, FDelegateHandle& OutHandle)
+        {
+            using Traits = TListenerTraits<Index>;
+
+            if constexpr (std::is_same_v<std::remove_cv_t<decltype(ListenerAt<Index>)>, MethodType> &&
+                std::is_same_v<typename Traits::ObjectType, ObjectType>)
+            {
+                if (ListenerAt<Index> != InMethod || std::get<Index>(Objects) != nullptr) return false;
+
+                std::get<Index>(Objects) = InObjPtr;
+                Handles[Index] = FDelegateHandle(FDelegateHandle::GenerateNewHandle);
+                OutHandle = Handles[Index];
+                return true;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        template <typename Predicate, std::size_t... Indices>
+        void RemoveIf(Predicate&& InPredicate, std::index_sequence<Indices...>)
+        {
+            (RemoveAt<Indices>(InPredicate), ...);
+        }
+
+        template <std::size_t Index, typename Predicate>
+        void RemoveAt(Predicate& InPredicate)
+        {
+            if constexpr (TListenerTraits<Index>::bIsMember)
+            {
+                auto& Object = std::get<Index>(Objects);
+                if (!Object) return;
+
+                if (InPredicate(Index, static_cast<const void*>(Object)))
+                {
+                    Object = nullptr;
+                    Handles[Index].Reset();
+                }
+            }
+        }
+
+        template <std::size_t... Indices>
+        __forceinline void BroadcastImpl(std::index_sequence<Indices...>, TDelegateParam<ArgsType>&... Args) const
+        {
+            (InvokeAt<Indices>(Args...), ...);
+        }
+
+        template <std::size_t Index>
+        __forceinline void InvokeAt(TDelegateParam<ArgsType>&... Args) const
+        {
+            if constexpr (TListenerTraits<Index>::bIsMember)
+            {
+                if (auto* Object = std::get<Index>(Objects)) (Object->*ListenerAt<Index>)(std::forward<TDelegateParam<ArgsType>>(Args)...);
+            }
+            else
+            {
+                ListenerAt<Index>(std::forward<TDelegateParam<ArgsType>>(Args)...);
+            }
+        }
+
+    private:
+        std::tuple<typename TStaticListenerTraits<RetType(ArgsType...), decltype(Listeners)>::ObjectType*...> Objects{};
+        std::array<FDelegateHandle, NumListeners> Handles{};
+    };
+}
@@ -0,0 +1,85 @@
+#include "ThreadSafeMulticastDelegate.h"
+
+namespace Delegates
+{
+    namespace
+    {
+        constexpr uint32_t MaxReaderSlots = 256;
+
+        // One cache line per reader thread, so announcing an epoch never contends with other broadcasters.
+        struct alignas(64) FReaderSlot
+        {
+            std::atomic<uint64_t> Epoch{ 0 };
+            std::atomic<bool> bClaimed{ false };
+        };
+
+        FReaderSlot GReaderSlots[MaxReaderSlots];
+        std::atomic<uint64_t> GDelegateEpoch(1);
+
+        // Readers that found no free slot; while any is active nothing is reclaimed.
+        std::atomic<uint32_t> GOverflowReaders(0);
+
+        struct FThreadReaderState
+        {
+            FThreadReaderState()
+            {
+                for (FReaderSlot& Candidate : GReaderSlots)
+                {
+                    bool bExpected = false;
+                    if (Candidate.bClaimed.compare_exchange_strong(bExpected, true, std::memory_order_acq_rel))
+                    {
+                        Slot = &Candidate;
+                        break;
+                    }
+                }
+            }
+
+            ~FThreadReaderState()
+            {
+                if (Slot) Slot->bClaimed.store(false, std::memory_order_release);
+            }
+
+            FReaderSlot* Slot = nullptr;
+            uint32_t Depth = 0;
+        };
+
+        thread_local FThreadReaderState GThreadReader;
+    }
+
+    void FDelegateEpoch::EnterRead()
+    {
+        FThreadReaderState& Reader = GThreadReader;
+        if (Reader.Depth++ > 0) return;
+
+        if (Reader.Slot) Reader.Slot->Epoch.store(GDelegateEpoch.load(std::memory_order_acquire), std::memory_order_seq_cst);
+        else GOverflowReaders.fetch_add(1, std::memory_order_seq_cst);
+    }
+
+    void FDelegateEpoch::ExitRead()
+    {
+        FThreadReaderState& Reader = GThreadReader;
+        assert(Reader.Depth > 0);
+        if (--Reader.Depth > 0) return;
+
+        if (Reader.Slot) Reader.Slot->Epoch.store(0, std::memory_order_release);
+        else GOverflowReaders.fetch_sub(1, std::memory_order_release);
+    }
+
+    uint64_t FDelegateEpoch::Advance()
+    {
+        return GDelegateEpoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+    }
+
+    uint64_t FDelegateEpoch::GetOldestActiveEpoch()
+    {
+        if (GOverflowReaders.load(std::memory_order_seq_cst) > 0) return 0;
+
+        uint64_t Oldest = UINT64_MAX;
+        for (const FReaderSlot& Slot : GReaderSlots)
+        {
+            const uint64_t Epoch = Slot.Epoch.load(std::memory_order_seq_cst);
+            if (Epoch != 0 && Epoch < Oldest) Oldest = Epoch;
+        }
+        return Oldest;
+    }
+}
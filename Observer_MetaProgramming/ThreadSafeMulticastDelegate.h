@@ -0,0 +1,327 @@
+#pragma once
+#include <atomic>
+#include <mutex>
+
+#include "DelegateInstance.h"
+#include "DelegateMailbox.h"
+
+namespace Delegates
+{
+    // ======================= Epoch Reclamation =======================
+
+    // Epoch-based reclamation shared by all thread-safe delegates. A reader announces the current epoch in its own
+    // per-thread slot before loading a published pointer; a writer retires the old pointer with the epoch it advanced
+    // to, and frees it once no reader still announces an older epoch.
+    class FDelegateEpoch
+    {
+    public:
+        static void EnterRead();
+        static void ExitRead();
+
+        static uint64_t Advance();
+        static uint64_t GetOldestActiveEpoch();
+    };
+
+    struct FDelegateReadScope
+    {
+        FDelegateReadScope() { FDelegateEpoch::EnterRead(); }
+        ~FDelegateReadScope() { FDelegateEpoch::ExitRead(); }
+
+        FDelegateReadScope(const FDelegateReadScope&) = delete;
+        FDelegateReadScope& operator=(const FDelegateReadScope&) = delete;
+    };
+
+    // ================= TThreadSafeMulticastDelegate (RCU multicast) =================
+
+    // Broadcasters read an immutable listener array published by writers (copy-on-write). A broadcast takes no lock
+    // and touches no shared reference count, so it scales with the number of broadcasting threads and never waits
+    // on Add*/Remove. Writers are serialized among themselves and pay a copy of the array.
+    //
+    // A listener removed while a broadcast is in flight is skipped if that broadcast has not reached it yet.
+    // Listeners may be called from several threads at once and must be thread-safe themselves.
+    //
+    // A listener added with a target mailbox only runs on the mailbox's thread: a broadcast from any other thread posts
+    // it a copy of the arguments (see FDelegateMailbox), one from the mailbox's thread calls it directly. Its reference
+    // parameters then refer to the copy. The mailbox must outlive the listener and anything still posted to it.
+    // Delivery is not guaranteed: the mailbox is bounded and never blocks the broadcaster, so a post to a full one is
+    // dropped and the listener misses that call. Broadcast returns how many calls it dropped this way and
+    // GetNumDroppedPosts counts them over the delegate's lifetime; size the mailbox for the burst it has to absorb.
+    // Arguments too large for a mailbox cell are copied to the heap instead; move-only ones can't be marshalled, so
+    // such a signature's listeners can't be given a mailbox.
+    //
+    //   OnHealthChanged.AddRaw(&HUD, &HUD::Update, &GameThreadMailbox);
+    template <typename Signature>
+    class TThreadSafeMulticastDelegate;
+
+    template <typename RetType, typename... ArgsType>
+    class TThreadSafeMulticastDelegate<RetType(ArgsType...)>
+    {
+        // The listener's handle is kept in FListener, next to it.
+        using Unicast = TDelegateStorage<RetType(ArgsType...)>;
+
+        struct FListener
+        {
+            FDelegateHandle Handle;
+            Unicast Delegate;
+            const void* Owner = nullptr;
+            FDelegateMailbox* Mailbox = nullptr;
+            std::atomic<bool> bRemoved{ false };
+        };
+
+        using FEventArgs = std::tuple<std::decay_t<ArgsType>...>;
+
+        // What a broadcast posts to a listener's mailbox: the listener, kept alive, and a copy of the arguments.
+        template <typename ArgsStorage>
+        struct TMarshalledCall
+        {
+            void operator()()
+            {
+                // Removed since it was posted: skipped, like a listener a running broadcast has not reached yet.
+                if (Listener->bRemoved.load(std::memory_order_relaxed)) return;
+
+                std::apply([&](auto&... InArgs) { Listener->Delegate.ExecuteIfBound(static_cast<TDelegateParam<ArgsType>>(InArgs)...); }, GetArgs());
+            }
+
+            FEventArgs& GetArgs()
+            {
+                if constexpr (std::is_same_v<ArgsStorage, FEventArgs>) return Args;
+                else return *Args;
+            }
+
+            std::shared_ptr<FListener> Listener;
+            ArgsStorage Args;
+        };
+
+        // Only copyable arguments can be marshalled, since every posted call gets its own copy. Arguments that don't
+        // fit a mailbox cell next to the listener, or whose move may throw (the mailbox moves the call into its cell
+        // after claiming it), are boxed, at one allocation per post.
+        static constexpr bool bCanMarshal = std::is_copy_constructible_v<FEventArgs>;
+        static constexpr bool bBoxMarshalledArgs = sizeof(TMarshalledCall<FEventArgs>) > FDelegateMailbox::MaxMessageSize ||
+            alignof(TMarshalledCall<FEventArgs>) > alignof(std::max_align_t) || !std::is_nothrow_move_constructible_v<FEventArgs>;
+
+        using FMarshalledCall = TMarshalledCall<std::conditional_t<bBoxMarshalledArgs, std::unique_ptr<FEventArgs>, FEventArgs>>;
+
+        using FListenerArray = std::vector<std::shared_ptr<FListener>>;
+
+        struct FRetiredArray
+        {
+            const FListenerArray* Array = nullptr;
+            uint64_t Epoch = 0;
+        };
+
+    public:
+        TThreadSafeMulticastDelegate() = default;
+
+        TThreadSafeMulticastDelegate(const TThreadSafeMulticastDelegate&) = delete;
+        TThreadSafeMulticastDelegate& operator=(const TThreadSafeMulticastDelegate&) = delete;
+
+        // No broadcast may be running when the delegate is destroyed.
+        ~TThreadSafeMulticastDelegate()
+        {
+            delete Current.load(std::memory_order_acquire);
+            for (const FRetiredArray& Retired : RetiredArrays) delete Retired.Array;
+        }
+
+        bool IsBound() const
+        {
+            FDelegateReadScope Scope;
+            const FListenerArray* Listeners = Current.load(std::memory_order_seq_cst);
+            return Listeners && !Listeners->empty();
+        }
+
+        void Clear()
+        {
+            Publish([](FListenerArray& Listeners)
+                {
+                    for (const auto& Listener : Listeners) Listener->bRemoved.store(true, std::memory_order_relaxed);
+                    Listeners.clear();
+                });
+        }
+
+        FDelegateHandle AddStatic(TFuncPtr<RetType(ArgsType...)> Fn, FDelegateMailbox* InTargetThread = nullptr)
+        {
+            Unicast D; D.BindStatic(Fn);
+            return AddInternal(std::move(D), nullptr, InTargetThread);
+        }
+
+        template<typename Class>
+        FDelegateHandle AddRaw(Class* InObjPtr, TMemFuncPtr<Class, RetType(ArgsType...)> InMethod, FDelegateMailbox* InTargetThread = nullptr)
+        {
+            Unicast Delegate; Delegate.AddRaw(InObjPtr, InMethod);
+            return AddInternal(std::move(Delegate), InObjPtr, InTargetThread);
+        }
+        template<typename Class>
+        FDelegateHandle AddRaw(const Class* InObjPtr, TMemFuncPtr<const Class, RetType(ArgsType...)> InMethod, FDelegateMailbox* InTargetThread = nullptr)
+        {
+            Unicast Delegate; Delegate.AddRaw(InObjPtr, InMethod);
+            return AddInternal(std::move(Delegate), InObjPtr, InTargetThread);
+        }
+
+        // The weak object is the owner, for RemoveAll.
+        template<typename Class>
+        FDelegateHandle AddWeak(std::weak_ptr<Class> InWeak, TMemFuncPtr<Class, RetType(ArgsType...)> InMethod, FDelegateMailbox* InTargetThread = nullptr)
+        {
+            const void* Owner = InWeak.lock().get();
+            Unicast Delegate; Delegate.AddWeak(InWeak, InMethod);
+            return AddInternal(std::move(Delegate), Owner, InTargetThread);
+        }
+        template<typename Class>
+        FDelegateHandle AddWeak(std::weak_ptr<const Class> InWeak, TMemFuncPtr<const Class, RetType(ArgsType...)> InMethod, FDelegateMailbox* InTargetThread = nullptr)
+        {
+            const void* Owner = InWeak.lock().get();
+            Unicast Delegate; Delegate.AddWeak(InWeak, InMethod);
+            return AddInternal(std::move(Delegate), Owner, InTargetThread);
+        }
+
+        template<typename Func>
+        FDelegateHandle AddLambda(Func&& InFunc, FDelegateMailbox* InTargetThread = nullptr)
+        {
+            return AddLambda(nullptr, std::forward<Func>(InFunc), InTargetThread);
+        }
+
+        // InOwner only tags the listener for RemoveAll.
+        template<typename Func>
+        FDelegateHandle AddLambda(const void* InOwner, Func&& InFunc, FDelegateMailbox* InTargetThread = nullptr)
+        {
+            Unicast Delegate; Delegate.AddLambda(std::forward<Func>(InFunc));
+            return AddInternal(std::move(Delegate), InOwner, InTargetThread);
+        }
+
+        void Remove(FDelegateHandle InHandle)
+        {
+            if (!InHandle.IsValid()) return;
+
+            RemoveIf([&](const FListener& Listener) { return Listener.Handle == InHandle; });
+        }
+
+        void RemoveAll(const void* InOwner)
+        {
+            if (!InOwner) return;
+
+            RemoveIf([&](const FListener& Listener) { return Listener.Owner == InOwner; });
+        }
+
+        // Returns how many marshalled calls were dropped because their listener's mailbox was full.
+        size_t Broadcast(TDelegateParam<ArgsType>... Args) const
+        {
+            FDelegateReadScope Scope;
+
+            const FListenerArray* Listeners = Current.load(std::memory_order_seq_cst);
+            if (!Listeners) return 0;
+
+            size_t NumDropped = 0;
+
+            for (const auto& Listener : *Listeners)
+            {
+                if (Listener->bRemoved.load(std::memory_order_relaxed)) continue;
+
+                if constexpr (bCanMarshal)
+                {
+                    if (FDelegateMailbox* Mailbox = Listener->Mailbox; Mailbox && !Mailbox->IsOwnerThread())
+                    {
+                        bool bPosted;
+                        if constexpr (bBoxMarshalledArgs) bPosted = Mailbox->TryPost(FMarshalledCall{ Listener, std::make_unique<FEventArgs>(Args...) });
+                        else bPosted = Mailbox->TryPost(FMarshalledCall{ Listener, FEventArgs(Args...) });
+
+                        if (!bPosted) ++NumDropped;
+                        continue;
+                    }
+                }
+
+                Listener->Delegate.ExecuteIfBound(std::forward<TDelegateParam<ArgsType>>(Args)...);
+            }
+
+            if (NumDropped > 0) NumDroppedPosts.fetch_add(NumDropped, std::memory_order_relaxed);
+            return NumDropped;
+        }
+
+        // Marshalled calls dropped by every Broadcast so far, from all threads.
+        __forceinline uint64_t GetNumDroppedPosts() const { return NumDroppedPosts.load(std::memory_order_relaxed); }
+
+    private:
+        FDelegateHandle AddInternal(Unicast&& InDelegate, const void* InOwner, FDelegateMailbox* InTargetThread)
+        {
+            if constexpr (!bCanMarshal)
+            {
+                assert(!InTargetThread && "Listeners taking move-only arguments cannot be bound to a mailbox");
+                if (InTargetThread) return FDelegateHandle{};
+            }
+
+            auto Listener = std::make_shared<FListener>();
+            Listener->Handle = FDelegateHandle(FDelegateHandle::GenerateNewHandle);
+            Listener->Delegate = std::move(InDelegate);
+            Listener->Owner = InOwner;
+            Listener->Mailbox = InTargetThread;
+
+            const FDelegateHandle Result = Listener->Handle;
+            Publish([&](FListenerArray& Listeners) { Listeners.emplace_back(std::move(Listener)); });
+            return Result;
+        }
+
+        template <typename Predicate>
+        void RemoveIf(Predicate&& InPredicate)
+        {
+            Publish([&](FListenerArray& Listeners)
+                {
+                    Listeners.erase(
+                        std::remove_if(Listeners.begin(), Listeners.end(),
+                            [&](const std::shared_ptr<FListener>& Listener)
+                            {
+                                if (!InPredicate(*Listener)) return false;
+
+                                Listener->bRemoved.store(true, std::memory_order_relaxed);
+                                return true;
+                            }),
+                        Listeners.end());
+                });
+        }
+
+        // Copies the current array, lets InModify edit the copy and publishes it. Dead bindings are pruned here,
+        // since broadcasters never write.
+        template <typename ModifyFunc>
+        void Publish(ModifyFunc&& InModify)
+        {
+            std::lock_guard<std::mutex> Lock(WriteMutex);
+
+            const FListenerArray* Previous = Current.load(std::memory_order_relaxed);
+
+            auto* Next = Previous ? new FListenerArray(*Previous) : new FListenerArray();
+            InModify(*Next);
+
+            Next->erase(
+                std::remove_if(Next->begin(), Next->end(),
+                    [](const std::shared_ptr<FListener>& Listener) { return !Listener->Delegate.IsBound(); }),
+                Next->end());
+
+            Current.exchange(Next, std::memory_order_seq_cst);
+
+            if (Previous) RetiredArrays.push_back({ Previous, FDelegateEpoch::Advance() });
+            ReclaimRetired();
+        }
+
+        void ReclaimRetired()
+        {
+            if (RetiredArrays.empty()) return;
+
+            const uint64_t OldestActive = FDelegateEpoch::GetOldestActiveEpoch();
+
+            RetiredArrays.erase(
+                std::remove_if(RetiredArrays.begin(), RetiredArrays.end(),
+                    [&](const FRetiredArray& Retired)
+                    {
+                        if (Retired.Epoch > OldestActive) return false;
+
+                        delete Retired.Array;
+                        return true;
+                    }),
+                RetiredArrays.end());
+        }
+
+    private:
+        std::atomic<const FListenerArray*> Current{ nullptr };
+        mutable std::atomic<uint64_t> NumDroppedPosts{ 0 };
+
+        std::mutex WriteMutex;
+        std::vector<FRetiredArray> RetiredArrays;
+    };
+}